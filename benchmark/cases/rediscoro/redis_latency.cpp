@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
@@ -24,6 +25,8 @@ struct bench_state {
   std::string host{"127.0.0.1"};
   int port = 6379;
   std::string payload{};
+  int read_spin_us = 0;
+  int busy_poll_us = 0;
   std::mutex latency_mtx{};
   std::vector<double> latencies_us{};
 };
@@ -43,6 +46,14 @@ auto percentile_sorted(std::vector<double> const& sorted, double q) -> double {
   return sorted[idx];
 }
 
+// Low-latency read knobs come from the environment so scenario rows stay shared with the
+// boost::redis case: REDISCORO_BENCH_READ_SPIN_US (config::read_spin budget) and
+// REDISCORO_BENCH_BUSY_POLL_US (socket_options::busy_poll). Unset or 0 disables them.
+auto env_int(char const* name) -> int {
+  auto const* v = std::getenv(name);
+  return v != nullptr ? std::atoi(v) : 0;
+}
+
 void mark_done(bench_state* st) {
   if (st->remaining_sessions.fetch_sub(1, std::memory_order_acq_rel) == 1) {
     st->ctx->stop();
@@ -63,6 +74,13 @@ auto run_session(bench_state* st) -> iocoro::awaitable<void> {
   cfg.host = st->host;
   cfg.port = st->port;
   cfg.reconnection.enabled = false;
+  if (st->read_spin_us > 0) {
+    cfg.read_spin.enabled = true;
+    cfg.read_spin.budget = std::chrono::microseconds{st->read_spin_us};
+  }
+  if (st->busy_poll_us > 0) {
+    cfg.socket.busy_poll = std::chrono::microseconds{st->busy_poll_us};
+  }
 
   rediscoro::client c{ex, cfg};
   auto cr = co_await c.connect();
@@ -137,6 +155,8 @@ int main(int argc, char* argv[]) {
   st.host = std::move(host);
   st.port = port;
   st.payload.assign(msg_bytes, 'x');
+  st.read_spin_us = env_int("REDISCORO_BENCH_READ_SPIN_US");
+  st.busy_poll_us = env_int("REDISCORO_BENCH_BUSY_POLL_US");
   st.latencies_us.reserve(static_cast<std::size_t>(sessions) * static_cast<std::size_t>(msgs));
 
   auto guard = iocoro::make_work_guard(ctx);
@@ -197,6 +217,8 @@ int main(int argc, char* argv[]) {
             << " sessions=" << sessions
             << " msgs=" << msgs
             << " msg_bytes=" << msg_bytes
+            << " read_spin_us=" << st.read_spin_us
+            << " busy_poll_us=" << st.busy_poll_us
             << " samples=" << sample_count
             << " elapsed_s=" << elapsed_s
             << " rps=" << rps
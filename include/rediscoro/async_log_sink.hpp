@@ -0,0 +1,222 @@
+#pragma once
+
+#include <rediscoro/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+namespace rediscoro {
+
+/// Log function that moves output off the logging thread.
+///
+/// Records (already formatted by `logger`) are copied into a bounded lock-free ring and written
+/// by a background thread, so a log call costs one copy instead of a synchronous stream write.
+/// When the ring is full the record is dropped and counted (`dropped()`); logging never blocks.
+///
+/// Usage:
+///   rediscoro::async_log_sink sink{};
+///   sink.install();  // route `get_logger()` through the sink
+///   rediscoro::get_logger().set_log_level(rediscoro::log_level::info);
+///
+/// Notes:
+/// - Messages longer than `max_message_size` (and file names longer than `max_file_size`) are
+///   truncated.
+/// - The sink must outlive all logging through it. Its destructor restores the default log
+///   function if this sink is still the installed one (a function installed later is left in
+///   place), writes out pending records and joins the thread.
+/// - Like `logger::set_log_function`, `install()` should run before logging starts.
+class async_log_sink {
+ public:
+  static constexpr std::size_t max_message_size = 384;
+  static constexpr std::size_t max_file_size = 96;
+
+  /// `capacity` is rounded up to a power of two. `downstream` receives every record on the
+  /// background thread (default: one line per record on std::cerr).
+  explicit async_log_sink(std::size_t capacity = 8192, log_function downstream = nullptr,
+                          void* user_data = nullptr)
+      : mask_(round_up_pow2(capacity) - 1),
+        cells_(std::make_unique<cell[]>(mask_ + 1)),
+        downstream_(downstream != nullptr ? downstream : &write_stderr),
+        downstream_user_data_(downstream != nullptr ? user_data : nullptr) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    worker_ = std::thread([this]() { run(); });
+  }
+
+  async_log_sink(async_log_sink const&) = delete;
+  auto operator=(async_log_sink const&) -> async_log_sink& = delete;
+
+  ~async_log_sink() {
+    // Leave a log function installed after this sink alone.
+    auto& log = get_logger();
+    if (installed_ && log.get_log_function() == &async_log_sink::log_function_thunk &&
+        log.get_log_user_data() == this) {
+      log.set_log_function(nullptr);
+    }
+    stop_.store(true, std::memory_order_release);
+    wake();
+    worker_.join();
+  }
+
+  /// Route the global logger through this sink.
+  auto install() -> void {
+    get_logger().set_log_function(&async_log_sink::log_function_thunk, this);
+    installed_ = true;
+  }
+
+  /// Log function usable with `logger::set_log_function(fn, sink)`.
+  static void log_function_thunk(void* self, log_context const& ctx) {
+    (void)static_cast<async_log_sink*>(self)->push(ctx);
+  }
+
+  /// Queue one record. Returns false (and counts a drop) when the ring is full.
+  auto push(log_context const& ctx) noexcept -> bool {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    cell* c = nullptr;
+    for (;;) {
+      c = &cells_[pos & mask_];
+      auto const seq = c->seq.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    c->rec.assign(ctx);
+    c->seq.store(pos + 1, std::memory_order_release);
+    pushed_.fetch_add(1, std::memory_order_release);
+    wake();
+    return true;
+  }
+
+  /// Block until every record queued before this call has been written downstream.
+  auto flush() -> void {
+    auto const target = pushed_.load(std::memory_order_acquire);
+    auto done = written_.load(std::memory_order_acquire);
+    while (done < target) {
+      written_.wait(done, std::memory_order_acquire);
+      done = written_.load(std::memory_order_acquire);
+    }
+  }
+
+  /// Records dropped because the ring was full.
+  [[nodiscard]] auto dropped() const noexcept -> std::uint64_t {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct record {
+    log_level level = log_level::off;
+    int line = 0;
+    std::chrono::system_clock::time_point timestamp{};
+    std::uint16_t file_size = 0;
+    std::uint16_t message_size = 0;
+    char file[max_file_size];
+    char message[max_message_size];
+
+    auto assign(log_context const& ctx) noexcept -> void {
+      level = ctx.level;
+      line = ctx.line;
+      timestamp = ctx.timestamp;
+      file_size = static_cast<std::uint16_t>(std::min(ctx.file.size(), max_file_size));
+      // Keep the tail of long paths: that is the part `format_log_line` prints.
+      std::memcpy(file, ctx.file.data() + (ctx.file.size() - file_size), file_size);
+      message_size = static_cast<std::uint16_t>(std::min(ctx.message.size(), max_message_size));
+      std::memcpy(message, ctx.message.data(), message_size);
+    }
+
+    [[nodiscard]] auto context() const noexcept -> log_context {
+      return log_context{.level = level,
+                         .message = std::string_view{message, message_size},
+                         .file = std::string_view{file, file_size},
+                         .line = line,
+                         .timestamp = timestamp};
+    }
+  };
+
+  struct alignas(64) cell {
+    std::atomic<std::size_t> seq{0};
+    record rec{};
+  };
+
+  static auto round_up_pow2(std::size_t n) noexcept -> std::size_t {
+    std::size_t p = 2;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  static void write_stderr(void*, log_context const& ctx) {
+    std::cerr << format_log_line(ctx) << '\n';
+  }
+
+  auto wake() noexcept -> void {
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+  }
+
+  // Single consumer: write out every published record, in order.
+  auto drain() -> std::size_t {
+    std::size_t n = 0;
+    for (;;) {
+      cell& c = cells_[head_ & mask_];
+      if (c.seq.load(std::memory_order_acquire) != head_ + 1) {
+        return n;
+      }
+      downstream_(downstream_user_data_, c.rec.context());
+      c.seq.store(head_ + mask_ + 1, std::memory_order_release);
+      head_ += 1;
+      n += 1;
+    }
+  }
+
+  auto run() -> void {
+    for (;;) {
+      auto const seen = signal_.load(std::memory_order_acquire);
+      if (auto const n = drain(); n > 0) {
+        written_.fetch_add(n, std::memory_order_release);
+        written_.notify_all();
+        continue;
+      }
+      if (stop_.load(std::memory_order_acquire)) {
+        return;
+      }
+      signal_.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  std::size_t const mask_;
+  std::unique_ptr<cell[]> cells_;
+  log_function downstream_;
+  void* downstream_user_data_;
+  bool installed_{false};
+
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::size_t head_{0};  // consumer thread only
+  alignas(64) std::atomic<std::uint32_t> signal_{0};
+  std::atomic<std::uint64_t> pushed_{0};
+  std::atomic<std::uint64_t> written_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> stop_{false};
+
+  std::thread worker_{};
+};
+
+}  // namespace rediscoro
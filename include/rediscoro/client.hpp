@@ -1,17 +1,27 @@
 #pragma once
 
 #include <rediscoro/config.hpp>
+#include <rediscoro/detail/blocking_lane.hpp>
 #include <rediscoro/detail/connection.hpp>
 #include <rediscoro/error_info.hpp>
 #include <rediscoro/expected.hpp>
 #include <rediscoro/request.hpp>
 #include <rediscoro/response.hpp>
+#include <rediscoro/response_stream.hpp>
+#include <rediscoro/slow_request_log.hpp>
+#include <rediscoro/stats.hpp>
 
 #include <iocoro/any_io_executor.hpp>
 #include <iocoro/awaitable.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace rediscoro {
 
@@ -40,7 +50,9 @@ class client {
  public:
   /// Construct a client with the given executor and configuration.
   explicit client(iocoro::any_io_executor ex, config cfg)
-      : conn_(std::make_shared<detail::connection>(ex, std::move(cfg))) {}
+      : lane_(cfg.blocking_lane.enabled ? std::make_shared<detail::blocking_lane>(ex, cfg)
+                                        : nullptr),
+        conn_(std::make_shared<detail::connection>(ex, std::move(cfg))) {}
 
   /// Connect to Redis server.
   /// Performs TCP connection, authentication, and database selection.
@@ -49,20 +61,34 @@ class client {
   /// - expected<void, error_info>{} on success
   /// - unexpected(error_info) with error details on failure
   auto connect() -> iocoro::awaitable<expected<void, error_info>> {
+    if (lane_) {
+      lane_->reopen();
+    }
     co_return co_await conn_->connect();
   }
 
   /// Close the connection gracefully.
   /// Waits for pending requests to complete.
-  auto close() -> iocoro::awaitable<void> { co_return co_await conn_->close(); }
+  auto close() -> iocoro::awaitable<void> {
+    if (lane_) {
+      co_await lane_->close();
+    }
+    co_return co_await conn_->close();
+  }
 
   /// Execute a request and wait for response(s) (fixed-size, heterogenous).
   ///
   /// For a single command, use Ts... of size 1:
   ///   auto r = co_await client.exec<std::string>("GET", "key");
   ///   auto& slot = r.get<0>();
+  ///
+  /// With `config::blocking_lane` enabled, requests containing a blocking command run on a
+  /// dedicated lane connection instead (see `blocking_lane_options`).
   template <typename... Ts>
   auto exec(request req) -> iocoro::awaitable<response<Ts...>> {
+    if (lane_ && detail::blocking_lane::accepts(req)) {
+      co_return co_await lane_->exec<Ts...>(std::move(req));
+    }
     auto pending = conn_->enqueue<Ts...>(std::move(req));
     co_return co_await pending->wait();
   }
@@ -71,6 +97,9 @@ class client {
   template <typename T, typename... Args>
   auto exec(Args&&... args) -> iocoro::awaitable<response<T>> {
     request req{std::forward<Args>(args)...};
+    if (lane_ && detail::blocking_lane::accepts(req)) {
+      co_return co_await lane_->exec<T>(std::move(req));
+    }
     auto pending = conn_->enqueue<T>(std::move(req));
     co_return co_await pending->wait();
   }
@@ -78,16 +107,93 @@ class client {
   /// Execute a request and wait for response(s) (dynamic-size, homogeneous).
   template <typename T>
   auto exec_dynamic(request req) -> iocoro::awaitable<dynamic_response<T>> {
+    if (lane_ && detail::blocking_lane::accepts(req)) {
+      co_return co_await lane_->exec_dynamic<T>(std::move(req));
+    }
     auto pending = conn_->enqueue_dynamic<T>(std::move(req));
     co_return co_await pending->wait();
   }
 
+  /// Execute a request and consume its replies one by one as they arrive (homogeneous).
+  ///
+  /// Returns immediately; see `response_stream` for buffering and backpressure. While a stream
+  /// is paused, replies of later requests on this client wait behind it.
+  /// Always runs on the main connection (blocking-lane routing does not apply).
+  template <typename T>
+  auto exec_stream(request req, std::size_t max_buffered = 1024U) -> response_stream<T> {
+    return response_stream<T>{conn_->enqueue_stream<T>(std::move(req), max_buffered)};
+  }
+
+  /// Execute independent requests as one batch (homogeneous reply type).
+  ///
+  /// All requests are handed to the connection with a single strand dispatch and a single
+  /// writer wakeup, instead of one per `exec()` call. Requests stay independent: each is admitted,
+  /// rejected, timed out, and answered on its own. Element i of the result holds the replies of
+  /// `reqs[i]`.
+  ///
+  /// With `config::blocking_lane` enabled, blocking requests in the batch are still routed to the
+  /// lane (one after another, while the rest of the batch is in flight).
+  template <typename T>
+  auto exec_batch(std::vector<request> reqs)
+    -> iocoro::awaitable<std::vector<dynamic_response<T>>> {
+    std::vector<dynamic_response<T>> out{};
+    out.reserve(reqs.size());
+
+    if (!lane_ || std::ranges::none_of(reqs, &detail::blocking_lane::accepts)) {
+      auto pending = conn_->enqueue_batch<T>(std::move(reqs));
+      for (auto& p : pending) {
+        out.push_back(co_await p->wait());
+      }
+      co_return out;
+    }
+
+    std::vector<request> main_reqs{};
+    std::vector<std::optional<request>> laned(reqs.size());
+    for (std::size_t i = 0; i < reqs.size(); ++i) {
+      if (detail::blocking_lane::accepts(reqs[i])) {
+        laned[i] = std::move(reqs[i]);
+      } else {
+        main_reqs.push_back(std::move(reqs[i]));
+      }
+    }
+    auto pending = conn_->enqueue_batch<T>(std::move(main_reqs));
+    std::size_t next = 0;
+    for (auto& req : laned) {
+      if (req.has_value()) {
+        out.push_back(co_await lane_->exec_dynamic<T>(std::move(*req)));
+      } else {
+        out.push_back(co_await pending[next++]->wait());
+      }
+    }
+    co_return out;
+  }
+
+  /// Snapshot of the main connection's built-in counters and gauges (see `connection_stats`).
+  ///
+  /// Cheap and non-blocking: reads relaxed atomics and never touches the connection strand.
+  /// Blocking-lane connections are not included.
+  [[nodiscard]] auto stats() const noexcept -> connection_stats { return conn_->stats(); }
+
+  /// Slow requests recorded by the main connection, oldest first (see
+  /// `config::slow_requests`; empty when disabled).
+  [[nodiscard]] auto slow_requests() const -> std::vector<slow_request_record> {
+    return conn_->slow_requests();
+  }
+
+  /// Timeout `config::adaptive_timeout` currently derives for `verb` on the main connection
+  /// (nullopt while the verb falls back to `request_timeout`, or when disabled).
+  auto adaptive_timeout(std::string verb)
+    -> iocoro::awaitable<std::optional<std::chrono::nanoseconds>> {
+    co_return co_await conn_->adaptive_timeout_for(std::move(verb));
+  }
+
   /// Check if client is connected.
   [[nodiscard]] bool is_connected() const noexcept {
     return conn_->state() == detail::connection_state::OPEN;
   }
 
  private:
+  std::shared_ptr<detail::blocking_lane> lane_;  // null unless config::blocking_lane.enabled
   std::shared_ptr<detail::connection> conn_;
 };
 
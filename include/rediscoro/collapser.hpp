@@ -0,0 +1,139 @@
+#pragma once
+
+#include <rediscoro/client.hpp>
+#include <rediscoro/response.hpp>
+
+#include <iocoro/any_executor.hpp>
+#include <iocoro/any_io_executor.hpp>
+#include <iocoro/awaitable.hpp>
+#include <iocoro/condition_event.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rediscoro {
+
+/// Options for request collapsing.
+struct collapser_options {
+  /// How long the first read of a batch waits for others to join before the batch is sent.
+  /// Zero flushes on the next executor turn, which still merges reads issued back-to-back.
+  std::chrono::microseconds window{0};
+
+  /// Upper bound on distinct keys (or hash fields) per collapsed command.
+  /// A batch that reaches this size is sent immediately without waiting for the window.
+  std::size_t max_keys = 256;
+};
+
+namespace detail {
+
+struct collapse_waiter {
+  std::optional<response_slot<std::optional<std::string>>> result{};
+  iocoro::condition_event ready{};
+};
+
+/// One open MGET / HMGET batch.
+///
+/// `args` holds the distinct keys (or fields) in first-seen order; `index` maps each argument to
+/// its reply position so duplicate reads share one slot.
+struct collapse_batch {
+  std::string hash_key{};  // empty for MGET
+  bool is_hash = false;
+  bool flushed = false;
+  std::vector<std::string> args{};
+  std::unordered_map<std::string, std::size_t> index{};
+  std::vector<std::pair<std::size_t, std::shared_ptr<collapse_waiter>>> waiters{};
+};
+
+class collapser_state;
+
+}  // namespace detail
+
+/// Optional batching layer that collapses concurrent single-key reads.
+///
+/// Concurrent `get(key)` calls that land in the same window are sent as one MGET, and concurrent
+/// `hget(key, field)` calls on the same hash as one HMGET. Identical keys within a batch are
+/// requested once and the reply is copied to every waiter.
+///
+/// Trade-off: each read may wait up to `collapser_options::window` for company; with the default
+/// zero window it only waits for the current executor turn to finish.
+///
+/// Differences from issuing GET / HGET directly:
+/// - MGET reports a key holding a non-string value as nil, so `get()` yields nullopt where GET
+///   would fail with WRONGTYPE.
+/// - An error for the collapsed command (connection loss, timeout, queue full) fails every read
+///   in its batch, including reads of unrelated keys. HMGET batches share one hash key, so a
+///   WRONGTYPE there fails exactly the reads HGET would have failed.
+///
+/// Thread safety:
+/// - `get()` / `hget()` can be called from any executor.
+/// - Batch bookkeeping is serialized on an internal strand.
+///
+/// Lifetime:
+/// - The client must outlive every collapsed read issued through this object.
+///
+/// Usage:
+///   collapser col{ctx.get_executor(), c};
+///   auto v = co_await col.get("key");  // response_slot<std::optional<std::string>>
+class collapser {
+ public:
+  using value_type = std::optional<std::string>;
+
+  explicit collapser(iocoro::any_io_executor ex, client& c, collapser_options opts = {});
+
+  /// Read a string key: nullopt when the key does not exist, or holds a non-string value (MGET
+  /// semantics; see the class notes).
+  auto get(std::string key) -> iocoro::awaitable<response_slot<value_type>>;
+
+  /// Read a hash field: nullopt when the key or field does not exist (HMGET semantics, which
+  /// match HGET for a single field).
+  auto hget(std::string key, std::string field) -> iocoro::awaitable<response_slot<value_type>>;
+
+ private:
+  std::shared_ptr<detail::collapser_state> state_;
+};
+
+namespace detail {
+
+class collapser_state : public std::enable_shared_from_this<collapser_state> {
+ public:
+  using value_type = std::optional<std::string>;
+
+  collapser_state(iocoro::any_io_executor ex, client& c, collapser_options opts);
+
+  [[nodiscard]] auto strand() const noexcept -> iocoro::any_executor { return strand_; }
+
+  /// Add one read to the open batch for `hash_key` (or the MGET batch). Strand only.
+  void join(bool is_hash, std::string hash_key, std::string arg,
+            std::shared_ptr<collapse_waiter> waiter);
+
+ private:
+  auto open_batch(bool is_hash, const std::string& hash_key) -> std::shared_ptr<collapse_batch>&;
+  void seal(const std::shared_ptr<collapse_batch>& batch);
+  void schedule_flush(const std::shared_ptr<collapse_batch>& batch);
+
+  static auto flush_after_window(std::shared_ptr<collapser_state> self,
+                                 std::shared_ptr<collapse_batch> batch) -> iocoro::awaitable<void>;
+  static auto flush(std::shared_ptr<collapser_state> self, std::shared_ptr<collapse_batch> batch)
+    -> iocoro::awaitable<void>;
+  static void complete(collapse_batch& batch, const response_slot<std::vector<value_type>>& reply);
+
+  iocoro::any_io_executor io_executor_{};
+  iocoro::any_executor strand_;
+  client* client_;
+  collapser_options opts_{};
+
+  std::shared_ptr<collapse_batch> open_mget_{};
+  std::unordered_map<std::string, std::shared_ptr<collapse_batch>> open_hmget_{};
+};
+
+}  // namespace detail
+
+}  // namespace rediscoro
+
+#include <rediscoro/impl/collapser.ipp>
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <rediscoro/key_tracker.hpp>
+#include <rediscoro/latency_recorder.hpp>
+#include <rediscoro/slow_request_log.hpp>
 #include <rediscoro/tracing.hpp>
 
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -71,12 +75,233 @@ struct client_limits {
   pipeline_backpressure_limits pipeline{};
 };
 
+/// Auto-pipelining (write coalescing) configuration.
+///
+/// Requests submitted by many coroutines are queued on the connection strand one by one. With
+/// auto-pipelining enabled, everything queued before the writer runs again (typically all requests
+/// submitted within the same executor turn, or while the previous write was in flight) is copied
+/// into one outgoing buffer and flushed with a single socket write. Each caller still gets its own
+/// reply slot; replies are matched in FIFO order as usual.
+struct auto_pipelining_options {
+  bool enabled = false;
+
+  /// Upper bound on the bytes gathered into one coalesced write.
+  /// A single request larger than this is written on its own (zero-copy).
+  std::size_t max_batch_bytes = 64ULL * 1024ULL;  // 64 KiB
+
+  /// Upper bound on the number of requests gathered into one coalesced write.
+  std::size_t max_batch_requests = 1024U;
+};
+
+/// Deduplication of identical in-flight read-only requests ("singleflight").
+///
+/// When enabled, a request whose encoded bytes match a request that is already in flight shares
+/// that request's server round trip and receives a copy of its replies instead of being sent
+/// again. Only requests made entirely of read-only, deterministic commands (GET, HGETALL,
+/// ZRANGE, ...) are eligible; anything else, including unknown commands, is always sent.
+///
+/// Trade-off: a deduplicated caller may observe a reply the server produced slightly before its
+/// own call was issued (never older than the in-flight request it joined).
+struct singleflight_options {
+  bool enabled = false;
+
+  /// Maximum number of distinct requests tracked at once; extra requests bypass deduplication.
+  std::size_t max_inflight_keys = 1024U;
+
+  /// Requests whose encoded size exceeds this bypass deduplication (bounds key memory).
+  std::size_t max_key_bytes = 1024U;
+};
+
+/// Dedicated connections for blocking commands.
+///
+/// A blocking command (BLPOP, BRPOP, BLMOVE, BZPOPMIN, XREAD/XREADGROUP with BLOCK, ...) holds
+/// its connection until the server replies, stalling every reply queued behind it. With the lane
+/// enabled, `client` routes requests containing such commands to a small pool of separate,
+/// lazily-connected connections, each carrying one blocking request at a time, so the main
+/// connection keeps flowing. WAIT and WAITAOF stay on the main connection: they count
+/// acknowledgements of that connection's own writes.
+struct blocking_lane_options {
+  bool enabled = false;
+
+  /// Maximum number of lane connections (= concurrent blocking requests).
+  /// Blocking requests beyond this fail with client_errc::queue_full.
+  std::size_t max_connections = 4U;
+
+  /// Request timeout on lane connections, replacing config::request_timeout there.
+  /// nullopt (default): wait as long as the command blocks on the server, so a long block
+  /// timeout never counts as a stalled connection.
+  std::optional<std::chrono::milliseconds> request_timeout{};
+};
+
+/// Caching of resolved endpoints across connects and reconnects.
+///
+/// Without caching every connect (including each reconnect attempt) resolves `host` again on the
+/// resolver's background thread. With caching, resolved endpoints are reused for `ttl`; after
+/// that they are still used immediately while a background resolve refreshes them. If none of
+/// the cached endpoints accepts a connection, the host is resolved again before giving up.
+struct endpoint_cache_options {
+  bool enabled = false;
+
+  /// How long resolved endpoints are considered fresh.
+  std::chrono::milliseconds ttl{30000};
+
+  /// Try the endpoint of the last successful connect first (applies with or without caching).
+  bool prefer_last_endpoint = true;
+};
+
+/// Offline buffering of requests across reconnects.
+///
+/// Without buffering, a connection loss fails every queued and in-flight request, and requests
+/// submitted while reconnecting fail with connection_lost. With buffering enabled (requires
+/// `reconnection.enabled`), requests that were not yet written are kept and sent on the new
+/// connection, and requests submitted while reconnecting are queued behind them, turning a short
+/// network blip into a latency spike instead of a burst of errors. `request_timeout` still
+/// applies to buffered requests.
+struct offline_buffer_options {
+  bool enabled = false;
+
+  /// Bounds of the buffer; requests beyond them fail as without buffering
+  /// (submissions while reconnecting fail with client_errc::queue_full).
+  std::size_t max_requests = 1024U;
+  std::size_t max_bytes = 1024ULL * 1024ULL;  // 1 MiB
+
+  /// Also resend read-only requests (GET, HGETALL, ...) that were written but not yet answered
+  /// when the connection dropped. Other written requests may already have run on the server and
+  /// always fail with the connection error.
+  bool replay_reads = true;
+};
+
+/// Warm standby connection for fast failover.
+///
+/// Reconnecting after a failure pays resolve + TCP connect + handshake before requests flow
+/// again. With a standby enabled, a second, fully handshaked connection is kept idle next to the
+/// active one; when the active connection fails it is promoted immediately (no reconnect delay)
+/// and a new standby is opened in the background. Falls back to regular reconnection while no
+/// standby is ready. Requires `reconnection.enabled`.
+///
+/// Trade-off: one extra idle server connection per client. A standby that died silently (e.g.
+/// the server restarted) is only detected on first use, which then triggers a regular reconnect.
+struct standby_options {
+  bool enabled = false;
+
+  /// Delay before retrying after a standby could not be opened.
+  std::chrono::milliseconds retry_delay{1000};
+};
+
 struct socket_options {
   /// Disable Nagle's algorithm to reduce small-command latency.
   bool no_delay = true;
 
   /// Enable TCP keepalive probes for long-lived idle connections.
   bool keep_alive = true;
+
+  /// Kernel busy polling on blocking reads (Linux SO_BUSY_POLL), in microseconds.
+  /// nullopt (default): leave the system setting (`net.core.busy_read`) in effect.
+  /// Best-effort: if the kernel refuses it (unsupported, or above the sysctl limit without
+  /// CAP_NET_ADMIN), the connection is still used and a warning is logged.
+  std::optional<std::chrono::microseconds> busy_poll{};
+
+  /// Prefer busy polling over interrupt-driven processing (Linux SO_PREFER_BUSY_POLL).
+  /// Only applied together with `busy_poll`.
+  bool prefer_busy_poll = false;
+};
+
+/// Spin-before-sleep reads for latency-critical workloads.
+///
+/// Normally the reader parks on the reactor whenever the socket has no data, paying a wakeup
+/// (epoll + scheduling) for every reply. With spinning enabled, while replies are outstanding
+/// the reader first polls the socket with non-blocking reads for up to `budget` before parking,
+/// so replies arriving within the budget are picked up without a wakeup.
+///
+/// Trade-off: the spin occupies the executor thread (nothing else runs on it meanwhile) and
+/// burns CPU. Only worth it with a dedicated io_context thread and sub-budget server latency.
+struct read_spin_options {
+  bool enabled = false;
+
+  /// Maximum time spent spinning per read before falling back to the reactor.
+  std::chrono::microseconds budget{50};
+};
+
+/// Opportunistic read-ahead.
+///
+/// Normally each reader wakeup performs one socket read, parses it, and goes back to the reactor,
+/// even if more reply bytes already arrived meanwhile. With read-ahead enabled, while replies are
+/// still outstanding the reader keeps draining the socket with non-blocking reads (parsing after
+/// each one) until it would block, so deep pipelines are processed in fewer, larger batches per
+/// wakeup.
+///
+/// Trade-off: one extra (failing) non-blocking read per wakeup when no more data is available.
+struct read_ahead_options {
+  bool enabled = false;
+
+  /// Maximum number of additional reads per wakeup (bounds time spent before yielding).
+  std::size_t max_reads = 16U;
+};
+
+/// Periodic PING on idle connections.
+///
+/// Once the connection had no request in flight and parsed no reply for `interval`, the control
+/// loop sends a PING. Its round trip feeds `connection_stats::ping_rtt_ewma_us`. A PING left
+/// unanswered for `timeout` means the connection is half-open (e.g. the peer vanished without
+/// FIN/RST, which TCP alone may not notice for hours): it is failed with
+/// `client_errc::health_check_failed` and reconnected per `reconnection`.
+struct health_check_options {
+  bool enabled = false;
+
+  /// Idle time before a PING is sent.
+  std::chrono::milliseconds interval{std::chrono::seconds{5}};
+
+  /// Time a PING may stay unanswered.
+  std::chrono::milliseconds timeout{std::chrono::seconds{2}};
+};
+
+/// Request deadlines derived from observed latency (see `config::adaptive_timeout`).
+///
+/// Each connection tracks the latency of successful requests per command class (the verb of a
+/// single-command request) over fixed windows. When a window closes, the budget of each class
+/// becomes `multiplier` × its `percentile` latency in that window, clamped to [`min_timeout`,
+/// `request_timeout`]. Until a class collected `min_samples` in a window, and for pipelines,
+/// transactions and commands that may block, `request_timeout` applies unchanged.
+///
+/// An expired deadline fails the connection like `request_timeout` does (replies cannot be
+/// skipped), so keep the margin generous: the aim is to notice a stalled server in a fraction of
+/// the fixed timeout, not to cut off the latency tail.
+struct adaptive_timeout_options {
+  bool enabled = false;
+
+  /// Latency percentile a budget is derived from.
+  double percentile = 99.0;
+
+  /// Budget = percentile latency × multiplier.
+  double multiplier = 4.0;
+
+  /// Floor of every budget.
+  std::chrono::milliseconds min_timeout{100};
+
+  /// Samples a class needs in a window before its budget is used.
+  std::uint64_t min_samples = 200U;
+
+  /// Length of a measurement window.
+  std::chrono::milliseconds window{std::chrono::seconds{10}};
+};
+
+/// Per-connection flight recorder of slow requests (see `client::slow_requests()`).
+///
+/// Requests whose end-to-end latency reaches `threshold` are copied into a fixed-size ring with
+/// their verb, sizes, phase timestamps, connection generation and error. Enabling it adds a few
+/// clock reads per request; recording itself never allocates.
+struct slow_request_options {
+  bool enabled = false;
+
+  /// Minimum end-to-end latency of a recorded request.
+  std::chrono::microseconds threshold{std::chrono::milliseconds{10}};
+
+  /// Records kept (the oldest is overwritten).
+  std::size_t capacity = 64U;
+
+  /// Log the requests recorded since the previous dump (warning level) when the connection is
+  /// lost or closed.
+  bool dump_on_disconnect = true;
 };
 
 /// Client configuration.
@@ -103,25 +328,110 @@ struct config {
   /// TCP connection timeout.
   std::optional<std::chrono::milliseconds> connect_timeout{5000};
 
+  /// Connection attempt delay for hosts that resolve to several endpoints (RFC 8305).
+  ///
+  /// The next endpoint is tried once this delay elapses even if earlier attempts are still
+  /// pending (and immediately when one fails); the first to connect wins and the rest are
+  /// cancelled. `connect_timeout` still bounds each attempt.
+  /// If nullopt, endpoints are tried strictly one after another.
+  std::optional<std::chrono::milliseconds> connect_attempt_delay{250};
+
   /// Request timeout (per-request deadline).
   /// If nullopt, no timeout is applied (indefinite wait).
   std::optional<std::chrono::milliseconds> request_timeout{5000};
 
+  /// Latency-derived per-request deadlines; `request_timeout` stays their ceiling.
+  adaptive_timeout_options adaptive_timeout{};
+
+  /// Pipelined handshake.
+  ///
+  /// When enabled, requests submitted while `connect()` is in progress are queued instead of
+  /// failing with not_connected, and written right behind the handshake commands without waiting
+  /// for their replies (saving a round trip on startup).
+  /// With a non-zero `database`, queued requests are written only after SELECT succeeded, so
+  /// they never run against the wrong database.
+  ///
+  /// If the handshake fails, queued requests not written yet fail with the handshake error.
+  /// Requests already written behind it fail with `client_errc::outcome_unknown` and are never
+  /// replayed: the server executes them even when HELLO or AUTH was rejected (without RESP3,
+  /// or under the default user's permissions).
+  bool pipelined_handshake = false;
+
+  /// Inline resumption of waiting callers (single-threaded deployments only).
+  ///
+  /// Normally each completed request resumes its caller by scheduling it through the executor
+  /// queue (one hop per reply). When enabled, callers whose replies arrive in one socket read are
+  /// resumed directly on the connection's thread once that read has been processed, in reply
+  /// order.
+  ///
+  /// Precondition: the io_context runs on a single thread and every caller awaits on it. Stop
+  /// requests do not interrupt a waiting request in this mode; it completes with its reply, an
+  /// error, or `request_timeout`.
+  bool inline_resume = false;
+
+  /// Single-threaded deployment: bind the connection directly to the io executor.
+  ///
+  /// By default every connection serializes its internals on its own strand, so the client can
+  /// be used from any thread. When the io_context runs on exactly one thread, that thread already
+  /// serializes everything and the strand is pure overhead; enabling this skips it.
+  ///
+  /// Precondition: the io_context is run by a single thread and the client is only used from
+  /// that thread. Violating it is a data race.
+  bool single_threaded = false;
+
   // Socket behavior.
   socket_options socket{};
 
+  // Low-latency polling reads.
+  read_spin_options read_spin{};
+
+  // Extra non-blocking reads per wakeup.
+  read_ahead_options read_ahead{};
+
+  // Resolved endpoint reuse across reconnects.
+  endpoint_cache_options endpoint_cache{};
+
+  // Write coalescing across independent requests.
+  auto_pipelining_options auto_pipelining{};
+
+  // Sharing of identical in-flight read-only requests.
+  singleflight_options singleflight{};
+
+  // Separate connections for blocking commands.
+  blocking_lane_options blocking_lane{};
+
   // Resource / protocol limits.
   client_limits limits{};
 
   // Reconnection
   reconnection_policy reconnection{};
 
+  // Request buffering while reconnecting.
+  offline_buffer_options offline_buffer{};
+
+  // Pre-handshaked connection promoted on failure.
+  standby_options standby{};
+
+  // Idle-connection PING probing (RTT, half-open detection).
+  health_check_options health_check{};
+
   // Observability
   // Request-level tracing hooks.
   request_trace_hooks trace_hooks{};
 
   // Connection lifecycle hooks (connected/disconnected/closed instrumentation).
   connection_event_hooks connection_hooks{};
+
+  // Built-in latency histograms (overall and per command); none when null. Shared with the
+  // blocking lane, and with other clients configured with the same recorder.
+  std::shared_ptr<latency_recorder> latency{};
+
+  // Hot-key / big-key detection (sampled per `key_tracker_options::sample_every`); none when
+  // null. Shared like `latency`.
+  std::shared_ptr<key_tracker> key_tracking{};
+
+  // Slow-request flight recorder.
+  slow_request_options slow_requests{};
 };
 
 }  // namespace rediscoro
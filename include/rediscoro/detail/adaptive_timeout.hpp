@@ -0,0 +1,169 @@
+#pragma once
+
+#include <rediscoro/config.hpp>
+#include <rediscoro/detail/command_info.hpp>
+#include <rediscoro/latency_recorder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace rediscoro::detail {
+
+/// Per-command-class latency model behind `adaptive_timeout_options`.
+///
+/// Each class keeps two histograms: the window being filled and the last closed one. When a
+/// window closes (checked on `budget_for()`), every class's budget is recomputed from the window
+/// that just closed. Verbs beyond `max_classes` distinct names share one overflow class.
+///
+/// Thread-safety: connection strand only (histogram recording is atomic regardless).
+class adaptive_timeout {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  static constexpr std::size_t max_classes = 64;
+  static constexpr std::size_t max_class_name = 24;
+
+  /// Deadline budget of one request.
+  struct budget {
+    std::optional<std::chrono::nanoseconds> timeout{};  // nullopt: no deadline
+    latency_histogram* window{nullptr};  // records the request's latency on success, if set
+  };
+
+  adaptive_timeout(adaptive_timeout_options opts,
+                   std::optional<std::chrono::milliseconds> ceiling, clock::time_point now)
+      : opts_(opts), ceiling_(ceiling), window_end_(now + opts.window) {}
+
+  adaptive_timeout(adaptive_timeout const&) = delete;
+  auto operator=(adaptive_timeout const&) -> adaptive_timeout& = delete;
+
+  /// Budget of a request with the given encoded wire bytes (`request::wire()`).
+  auto budget_for(std::string_view wire, std::size_t command_count, clock::time_point now)
+    -> budget {
+    if (now >= window_end_) {
+      close_window(now);
+    }
+    // Pipelines and transactions take as long as all their commands; blocking commands (and
+    // WAIT-style ones) as long as the caller asked. Neither says anything about a class's round
+    // trip.
+    auto const verb = first_command_verb(wire);
+    auto const flags = lookup_command(verb);
+    if (command_count != 1 || has_flag(flags, command_flags::blocking) ||
+        has_flag(flags, command_flags::blocking_option) ||
+        has_flag(flags, command_flags::connection_bound)) {
+      return budget{.timeout = ceiling_};
+    }
+    auto& c = find_or_add(verb);
+    return budget{
+      .timeout = c.timeout.count() > 0 ? std::optional{c.timeout} : ceiling_,
+      .window = &c.current,
+    };
+  }
+
+  /// Budget currently derived for `verb` (nullopt while it falls back to the ceiling).
+  [[nodiscard]] auto class_timeout(std::string_view verb) const
+    -> std::optional<std::chrono::nanoseconds> {
+    name_buffer upper{};
+    command_class const* c = normalize(verb, upper) ? lookup(upper.view()) : &other_;
+    if (c == nullptr || c->timeout.count() == 0) {
+      return std::nullopt;
+    }
+    return c->timeout;
+  }
+
+ private:
+  struct command_class {
+    latency_histogram current{};
+    latency_histogram closed{};
+    std::chrono::nanoseconds timeout{0};  // 0: not enough samples
+  };
+
+  struct name_buffer {
+    std::array<char, max_class_name> data{};
+    std::size_t size{0};
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view { return {data.data(), size}; }
+  };
+
+  struct name_hash {
+    using is_transparent = void;
+    auto operator()(std::string_view s) const noexcept -> std::size_t {
+      return std::hash<std::string_view>{}(s);
+    }
+  };
+
+  auto close_window(clock::time_point now) -> void {
+    for (auto& [name, c] : classes_) {
+      roll(*c);
+    }
+    roll(other_);
+    window_end_ = now + opts_.window;
+  }
+
+  auto roll(command_class& c) const -> void {
+    c.closed.reset();
+    c.closed.merge(c.current);
+    c.current.reset();
+    if (c.closed.count() < std::max<std::uint64_t>(opts_.min_samples, 1)) {
+      c.timeout = std::chrono::nanoseconds{0};
+      return;
+    }
+    auto const observed = c.closed.value_at_percentile(opts_.percentile);
+    auto t = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double, std::nano>(static_cast<double>(observed.count()) *
+                                               opts_.multiplier));
+    t = std::max<std::chrono::nanoseconds>(t, opts_.min_timeout);
+    if (ceiling_.has_value()) {
+      t = std::min(t, *ceiling_);
+    }
+    c.timeout = std::max(t, std::chrono::nanoseconds{1});
+  }
+
+  auto find_or_add(std::string_view verb) -> command_class& {
+    name_buffer upper{};
+    if (!normalize(verb, upper)) {
+      return other_;
+    }
+    if (auto* c = lookup(upper.view()); c != nullptr) {
+      return *c;
+    }
+    if (classes_.size() >= max_classes) {
+      return other_;
+    }
+    auto it = classes_.emplace(std::string{upper.view()}, std::make_unique<command_class>()).first;
+    return *it->second;
+  }
+
+  [[nodiscard]] auto lookup(std::string_view upper) const -> command_class* {
+    auto it = classes_.find(upper);
+    return it != classes_.end() ? it->second.get() : nullptr;
+  }
+
+  static auto normalize(std::string_view verb, name_buffer& out) noexcept -> bool {
+    if (verb.empty() || verb.size() > max_class_name) {
+      return false;
+    }
+    for (std::size_t i = 0; i < verb.size(); ++i) {
+      out.data[i] = ascii_upper(verb[i]);
+    }
+    out.size = verb.size();
+    return true;
+  }
+
+  adaptive_timeout_options opts_;
+  std::optional<std::chrono::nanoseconds> ceiling_;
+  clock::time_point window_end_;
+  std::unordered_map<std::string, std::unique_ptr<command_class>, name_hash, std::equal_to<>>
+    classes_{};
+  command_class other_{};
+};
+
+}  // namespace rediscoro::detail
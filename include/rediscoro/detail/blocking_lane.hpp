@@ -0,0 +1,172 @@
+#pragma once
+
+#include <rediscoro/config.hpp>
+#include <rediscoro/detail/command_info.hpp>
+#include <rediscoro/detail/connection.hpp>
+#include <rediscoro/detail/pending_response.hpp>
+#include <rediscoro/error.hpp>
+#include <rediscoro/error_info.hpp>
+#include <rediscoro/expected.hpp>
+#include <rediscoro/request.hpp>
+#include <rediscoro/response.hpp>
+
+#include <iocoro/any_io_executor.hpp>
+#include <iocoro/awaitable.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace rediscoro::detail {
+
+/// Small pool of dedicated connections for blocking commands (see `blocking_lane_options`).
+///
+/// Each lane connection carries at most one request at a time: a request checks a connection
+/// out, runs to completion, and returns it. Connections are created and connected lazily on
+/// first use, so an application that never blocks never opens one.
+///
+/// Thread safety: all methods can be called from any executor (pool bookkeeping is guarded by a
+/// mutex; each connection serializes itself on its own strand).
+class blocking_lane : public std::enable_shared_from_this<blocking_lane> {
+ public:
+  blocking_lane(iocoro::any_io_executor ex, config const& base)
+      : executor_(ex), cfg_(base), max_connections_(base.blocking_lane.max_connections) {
+    cfg_.request_timeout = base.blocking_lane.request_timeout;
+    cfg_.blocking_lane.enabled = false;
+    cfg_.standby.enabled = false;  // short-lived, one request at a time: no failover pair
+    cfg_.adaptive_timeout.enabled = false;  // blocking commands have no typical latency
+    if (max_connections_ == 0) {
+      max_connections_ = 1;
+    }
+  }
+
+  /// True when `req` contains a command that may block on the server.
+  [[nodiscard]] static auto accepts(request const& req) -> bool {
+    // Every exec() passes through here: settle single commands on the verb alone and decode
+    // arguments only for XREAD-style verbs or pipelines (where any command may block).
+    if (req.command_count() == 1) {
+      auto const flags = lookup_command(first_command_verb(req.wire()));
+      if (!has_flag(flags, command_flags::blocking_option)) {
+        return has_flag(flags, command_flags::blocking);
+      }
+    }
+    return any_command_blocking(req.wire());
+  }
+
+  template <typename... Ts>
+  auto exec(request req) -> iocoro::awaitable<response<Ts...>> {
+    auto lease = co_await checkout();
+    if (!lease) {
+      auto failed = std::make_shared<pending_response<Ts...>>();
+      failed->fail_all(std::move(lease.error()));
+      co_return co_await failed->wait();
+    }
+    auto pending = lease->conn->template enqueue<Ts...>(std::move(req));
+    co_return co_await pending->wait();
+  }
+
+  template <typename T>
+  auto exec_dynamic(request req) -> iocoro::awaitable<dynamic_response<T>> {
+    auto lease = co_await checkout();
+    if (!lease) {
+      auto failed = std::make_shared<pending_dynamic_response<T>>(req.reply_count());
+      failed->fail_all(std::move(lease.error()));
+      co_return co_await failed->wait();
+    }
+    auto pending = lease->conn->template enqueue_dynamic<T>(std::move(req));
+    co_return co_await pending->wait();
+  }
+
+  /// Allow checkouts again after close() (client reconnect).
+  auto reopen() -> void {
+    std::lock_guard lock(mu_);
+    closed_ = false;
+  }
+
+  /// Close every lane connection; later blocking requests fail with connection_closed.
+  auto close() -> iocoro::awaitable<void> {
+    std::vector<std::shared_ptr<connection>> all{};
+    {
+      std::lock_guard lock(mu_);
+      closed_ = true;
+      idle_.clear();
+      all.swap(all_);
+    }
+    for (auto& conn : all) {
+      co_await conn->close();
+    }
+  }
+
+ private:
+  /// Exclusive use of one lane connection; returns it to the pool on destruction.
+  struct lease {
+    std::shared_ptr<blocking_lane> lane{};
+    std::shared_ptr<connection> conn{};
+
+    lease(std::shared_ptr<blocking_lane> l, std::shared_ptr<connection> c)
+        : lane(std::move(l)), conn(std::move(c)) {}
+    lease(lease&& other) noexcept = default;
+    lease(lease const&) = delete;
+    auto operator=(lease const&) -> lease& = delete;
+    auto operator=(lease&&) -> lease& = delete;
+
+    ~lease() {
+      if (lane && conn) {
+        lane->release(std::move(conn));
+      }
+    }
+  };
+
+  auto checkout() -> iocoro::awaitable<expected<lease, error_info>> {
+    std::shared_ptr<connection> conn{};
+    {
+      std::lock_guard lock(mu_);
+      if (closed_) {
+        co_return unexpected(error_info{client_errc::connection_closed, "blocking lane closed"});
+      }
+      if (!idle_.empty()) {
+        conn = std::move(idle_.back());
+        idle_.pop_back();
+      } else if (all_.size() < max_connections_) {
+        conn = std::make_shared<connection>(executor_, cfg_);
+        all_.push_back(conn);
+      } else {
+        co_return unexpected(error_info{client_errc::queue_full, "blocking lane exhausted"});
+      }
+    }
+
+    lease held{shared_from_this(), conn};
+    auto const state = conn->state();
+    if (state == connection_state::INIT || state == connection_state::CLOSED) {
+      REDISCORO_LOG_DEBUG("blocking lane connect: pool_size={}", max_connections_);
+      auto r = co_await conn->connect();
+      if (!r) {
+        co_return unexpected(std::move(r.error()));
+      }
+    }
+    co_return std::move(held);
+  }
+
+  auto release(std::shared_ptr<connection> conn) -> void {
+    std::lock_guard lock(mu_);
+    // After close() the pool no longer owns connections checked out before it ran.
+    if (closed_ || std::ranges::find(all_, conn) == all_.end()) {
+      return;
+    }
+    idle_.push_back(std::move(conn));
+  }
+
+  iocoro::any_io_executor executor_{};
+  config cfg_;
+  std::size_t max_connections_;
+
+  std::mutex mu_{};
+  bool closed_{false};
+  std::vector<std::shared_ptr<connection>> all_{};
+  std::vector<std::shared_ptr<connection>> idle_{};
+};
+
+}  // namespace rediscoro::detail
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace rediscoro::detail {
+
+/// Per-command classification bits.
+enum class command_flags : std::uint8_t {
+  none = 0,
+
+  /// Does not modify the dataset and returns the same reply for the same dataset state.
+  /// Non-deterministic reads (RANDOMKEY, SRANDMEMBER, ...) are deliberately NOT tagged.
+  read_only = 1U << 0,
+
+  /// May block on the server (BLPOP, BRPOP, ...), holding up every reply queued behind it.
+  blocking = 1U << 1,
+
+  /// Blocks only when a BLOCK option is present (XREAD, XREADGROUP).
+  blocking_option = 1U << 2,
+
+  /// Blocks, but only means something on the connection that made the preceding writes
+  /// (WAIT, WAITAOF count acknowledgements of its own writes). Never moved to another
+  /// connection; only exempt from latency-derived timeouts.
+  connection_bound = 1U << 3,
+};
+
+[[nodiscard]] constexpr auto operator|(command_flags a, command_flags b) noexcept -> command_flags {
+  return static_cast<command_flags>(static_cast<std::uint8_t>(a) | static_cast<std::uint8_t>(b));
+}
+
+[[nodiscard]] constexpr auto has_flag(command_flags v, command_flags f) noexcept -> bool {
+  return (static_cast<std::uint8_t>(v) & static_cast<std::uint8_t>(f)) != 0;
+}
+
+struct command_entry {
+  std::string_view name;  // upper-case
+  command_flags flags;
+};
+
+/// Classification table (sorted by name for binary search).
+///
+/// Commands not listed have no flags: unknown commands are always treated conservatively.
+inline constexpr auto command_table = std::to_array<command_entry>({
+  {"BITCOUNT", command_flags::read_only},
+  {"BITPOS", command_flags::read_only},
+  {"BLMOVE", command_flags::blocking},
+  {"BLMPOP", command_flags::blocking},
+  {"BLPOP", command_flags::blocking},
+  {"BRPOP", command_flags::blocking},
+  {"BRPOPLPUSH", command_flags::blocking},
+  {"BZMPOP", command_flags::blocking},
+  {"BZPOPMAX", command_flags::blocking},
+  {"BZPOPMIN", command_flags::blocking},
+  {"EXISTS", command_flags::read_only},
+  {"GEODIST", command_flags::read_only},
+  {"GEOHASH", command_flags::read_only},
+  {"GEOPOS", command_flags::read_only},
+  {"GET", command_flags::read_only},
+  {"GETBIT", command_flags::read_only},
+  {"GETRANGE", command_flags::read_only},
+  {"HEXISTS", command_flags::read_only},
+  {"HGET", command_flags::read_only},
+  {"HGETALL", command_flags::read_only},
+  {"HKEYS", command_flags::read_only},
+  {"HLEN", command_flags::read_only},
+  {"HMGET", command_flags::read_only},
+  {"HSTRLEN", command_flags::read_only},
+  {"HVALS", command_flags::read_only},
+  {"LINDEX", command_flags::read_only},
+  {"LLEN", command_flags::read_only},
+  {"LRANGE", command_flags::read_only},
+  {"MGET", command_flags::read_only},
+  {"PFCOUNT", command_flags::read_only},
+  {"PTTL", command_flags::read_only},
+  {"SCARD", command_flags::read_only},
+  {"SISMEMBER", command_flags::read_only},
+  {"SMEMBERS", command_flags::read_only},
+  {"SMISMEMBER", command_flags::read_only},
+  {"STRLEN", command_flags::read_only},
+  {"TTL", command_flags::read_only},
+  {"TYPE", command_flags::read_only},
+  {"WAIT", command_flags::connection_bound},
+  {"WAITAOF", command_flags::connection_bound},
+  {"XLEN", command_flags::read_only},
+  {"XRANGE", command_flags::read_only},
+  {"XREAD", command_flags::blocking_option},
+  {"XREADGROUP", command_flags::blocking_option},
+  {"XREVRANGE", command_flags::read_only},
+  {"ZCARD", command_flags::read_only},
+  {"ZCOUNT", command_flags::read_only},
+  {"ZLEXCOUNT", command_flags::read_only},
+  {"ZMSCORE", command_flags::read_only},
+  {"ZRANGE", command_flags::read_only},
+  {"ZRANGEBYLEX", command_flags::read_only},
+  {"ZRANGEBYSCORE", command_flags::read_only},
+  {"ZRANK", command_flags::read_only},
+  {"ZREVRANGE", command_flags::read_only},
+  {"ZREVRANGEBYSCORE", command_flags::read_only},
+  {"ZREVRANK", command_flags::read_only},
+  {"ZSCORE", command_flags::read_only},
+});
+
+static_assert(std::ranges::is_sorted(command_table, {}, &command_entry::name),
+              "command_table must be sorted by name");
+
+[[nodiscard]] constexpr auto ascii_upper(char c) noexcept -> char {
+  return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+[[nodiscard]] constexpr auto ascii_iequals(std::string_view a, std::string_view b) noexcept
+  -> bool {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (ascii_upper(a[i]) != ascii_upper(b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Look up the classification of a command verb (ASCII case-insensitive).
+[[nodiscard]] inline auto lookup_command(std::string_view verb) noexcept -> command_flags {
+  constexpr std::size_t max_name = 32;
+  if (verb.empty() || verb.size() > max_name) {
+    return command_flags::none;
+  }
+
+  std::array<char, max_name> buf{};
+  for (std::size_t i = 0; i < verb.size(); ++i) {
+    buf[i] = ascii_upper(verb[i]);
+  }
+  std::string_view upper{buf.data(), verb.size()};
+
+  auto it = std::ranges::lower_bound(command_table, upper, {}, &command_entry::name);
+  if (it == command_table.end() || it->name != upper) {
+    return command_flags::none;
+  }
+  return it->flags;
+}
+
+/// Read one RESP length header (`<prefix><digits>\r\n`) at `pos`, advancing `pos` past it.
+[[nodiscard]] inline auto read_wire_length(std::string_view wire, std::size_t& pos, char prefix,
+                                           std::size_t& out) noexcept -> bool {
+  if (pos >= wire.size() || wire[pos] != prefix) {
+    return false;
+  }
+  std::size_t p = pos + 1;
+  std::size_t v = 0;
+  bool any = false;
+  while (p < wire.size() && wire[p] >= '0' && wire[p] <= '9') {
+    v = v * 10 + static_cast<std::size_t>(wire[p] - '0');
+    ++p;
+    any = true;
+  }
+  if (!any || wire.size() - p < 2 || wire[p] != '\r' || wire[p + 1] != '\n') {
+    return false;
+  }
+  pos = p + 2;
+  out = v;
+  return true;
+}
+
+/// Decode the next command of an encoded request (`request::wire()`) into `argv`.
+///
+/// `pos` is advanced past the command. Returns false at end of input or on malformed input;
+/// `request` always produces well-formed wire bytes, so the latter only guards against misuse.
+/// The views in `argv` point into `wire`.
+[[nodiscard]] inline auto next_command(std::string_view wire, std::size_t& pos,
+                                       std::vector<std::string_view>& argv) -> bool {
+  argv.clear();
+
+  std::size_t argc = 0;
+  if (!read_wire_length(wire, pos, '*', argc)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < argc; ++i) {
+    std::size_t len = 0;
+    if (!read_wire_length(wire, pos, '$', len) || wire.size() - pos < len + 2) {
+      return false;
+    }
+    argv.push_back(wire.substr(pos, len));
+    pos += len + 2;
+  }
+  return true;
+}
+
+/// Argument `index` (0 is the verb) of the first command of an encoded request, without
+/// decoding the rest; empty when the command has no such argument or the request is malformed.
+/// The view points into `wire`.
+[[nodiscard]] inline auto first_command_argument(std::string_view wire, std::size_t index) noexcept
+  -> std::string_view {
+  // *<argc>\r\n$<len>\r\n<arg>\r\n...
+  std::size_t pos = 0;
+  std::size_t argc = 0;
+  if (!read_wire_length(wire, pos, '*', argc) || index >= argc) {
+    return {};
+  }
+  for (std::size_t i = 0;; ++i) {
+    std::size_t len = 0;
+    if (!read_wire_length(wire, pos, '$', len) || wire.size() - pos < len + 2) {
+      return {};
+    }
+    if (i == index) {
+      return wire.substr(pos, len);
+    }
+    pos += len + 2;
+  }
+}
+
+/// Verb of the first command of an encoded request (see `first_command_argument`).
+[[nodiscard]] inline auto first_command_verb(std::string_view wire) noexcept -> std::string_view {
+  return first_command_argument(wire, 0);
+}
+
+/// First argument after the verb of the first command (the key for most data commands), or
+/// empty when the command has none or the request is malformed. The view points into `wire`.
+[[nodiscard]] inline auto first_command_key(std::string_view wire) noexcept -> std::string_view {
+  return first_command_argument(wire, 1);
+}
+
+/// True when the decoded command may block on the server.
+[[nodiscard]] inline auto is_blocking_command(std::span<const std::string_view> argv) noexcept
+  -> bool {
+  if (argv.empty()) {
+    return false;
+  }
+  auto const flags = lookup_command(argv.front());
+  if (has_flag(flags, command_flags::blocking)) {
+    return true;
+  }
+  if (!has_flag(flags, command_flags::blocking_option)) {
+    return false;
+  }
+  // XREAD [COUNT n] [BLOCK ms] STREAMS ...
+  // XREADGROUP GROUP group consumer [COUNT n] [BLOCK ms] [NOACK] STREAMS ...
+  // Options precede STREAMS; option values (and the group/consumer names) are skipped so a
+  // consumer named BLOCK or a group named STREAMS is not mistaken for a keyword.
+  for (std::size_t i = 1; i < argv.size(); ++i) {
+    if (ascii_iequals(argv[i], "STREAMS")) {
+      return false;
+    }
+    if (ascii_iequals(argv[i], "BLOCK")) {
+      return true;
+    }
+    if (ascii_iequals(argv[i], "GROUP")) {
+      i += 2;
+    } else if (ascii_iequals(argv[i], "COUNT")) {
+      i += 1;
+    }
+  }
+  return false;
+}
+
+/// True when any command in the encoded request may block on the server.
+[[nodiscard]] inline auto any_command_blocking(std::string_view wire) -> bool {
+  std::vector<std::string_view> argv{};
+  std::size_t pos = 0;
+  while (pos < wire.size()) {
+    if (!next_command(wire, pos, argv)) {
+      return false;
+    }
+    if (is_blocking_command(argv)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// True when every command in the encoded request carries `flag`.
+[[nodiscard]] inline auto all_commands_have(std::string_view wire, command_flags flag) -> bool {
+  std::vector<std::string_view> argv{};
+  std::size_t pos = 0;
+  bool any = false;
+  while (pos < wire.size()) {
+    if (!next_command(wire, pos, argv) || argv.empty() ||
+        !has_flag(lookup_command(argv.front()), flag)) {
+      return false;
+    }
+    any = true;
+  }
+  return any;
+}
+
+}  // namespace rediscoro::detail
@@ -1,17 +1,29 @@
 #pragma once
 
 #include <rediscoro/config.hpp>
+#include <rediscoro/detail/adaptive_timeout.hpp>
 #include <rediscoro/detail/connection_executor.hpp>
+#include <rediscoro/detail/connection_metrics.hpp>
 #include <rediscoro/detail/connection_state.hpp>
+#include <rediscoro/detail/endpoint_cache.hpp>
+#include <rediscoro/detail/health_probe.hpp>
 #include <rediscoro/detail/pending_response.hpp>
 #include <rediscoro/detail/pipeline.hpp>
+#include <rediscoro/detail/probes.hpp>
+#include <rediscoro/detail/resume_queue.hpp>
+#include <rediscoro/detail/singleflight.hpp>
+#include <rediscoro/detail/socket_io.hpp>
 #include <rediscoro/detail/stop_scope.hpp>
+#include <rediscoro/detail/stream_sink.hpp>
 #include <rediscoro/error.hpp>
 #include <rediscoro/error_info.hpp>
 #include <rediscoro/expected.hpp>
+#include <rediscoro/ignore.hpp>
 #include <rediscoro/logger.hpp>
 #include <rediscoro/request.hpp>
 #include <rediscoro/resp3/parser.hpp>
+#include <rediscoro/slow_request_log.hpp>
+#include <rediscoro/stats.hpp>
 
 #include <iocoro/any_io_executor.hpp>
 #include <iocoro/awaitable.hpp>
@@ -20,9 +32,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -37,14 +52,19 @@ auto make_internal_error_from_current_exception(std::string_view context) -> err
 auto fail_sink_with_current_exception(std::shared_ptr<response_sink> const& sink,
                                       std::string_view context) noexcept -> void;
 
+struct connect_race;
+
 /// Core Redis connection actor.
 ///
 /// High-level model:
 /// - A single background actor (`actor_loop`) runs three strand-bound loops:
 ///   `write_loop`, `read_loop`, `control_loop`.
 /// - All state machine and pipeline mutations are serialized on the connection strand.
-/// - Requests are only accepted after a successful `connect()`; there is no buffering/replay
-///   across connection generations.
+/// - Requests are only accepted after a successful `connect()`; by default there is no
+///   buffering/replay across connection generations. With `config::pipelined_handshake`,
+///   requests submitted during the initial `CONNECTING` are held back and written behind the
+///   handshake; with `config::offline_buffer`, requests are held back (and replayable ones
+///   parked) while `FAILED`/`RECONNECTING`.
 ///
 /// Concurrency notes:
 /// - The socket is full-duplex: at most one in-flight read and one in-flight write are allowed
@@ -72,6 +92,8 @@ class connection : public std::enable_shared_from_this<connection> {
   /// - All state mutations happen on the strand (to avoid races with the actor loops).
   /// - Handshake is implemented as a regular pipelined request (HELLO/AUTH/SELECT/CLIENT SETNAME),
   ///   and `do_connect()` drives the corresponding socket IO directly while `state_ != OPEN`.
+  /// - With `config::pipelined_handshake`, requests queued while `CONNECTING` are accepted and
+  ///   fail with the connect/handshake error if `connect()` fails.
   /// - On failure, cleanup is unified via `close()` (which joins the actor). `connect()` itself
   ///   does not await the actor directly.
   /// - Automatic reconnection applies only to runtime failures after reaching `OPEN`.
@@ -107,16 +129,49 @@ class connection : public std::enable_shared_from_this<connection> {
   template <typename T>
   auto enqueue_dynamic(request req) -> std::shared_ptr<pending_dynamic_response<T>>;
 
+  /// Enqueue a pipeline request whose replies are consumed one by one (see `response_stream`).
+  /// At most `max_buffered` unconsumed replies are held before the reader pauses.
+  template <typename T>
+  auto enqueue_stream(request req, std::size_t max_buffered) -> std::shared_ptr<stream_sink<T>>;
+
+  /// Enqueue independent requests in one go (homogeneous reply type).
+  ///
+  /// All requests cross into the strand with a single dispatch and wake the writer once; the
+  /// i-th returned slot receives the replies of `reqs[i]`. Each request is admitted (or
+  /// rejected) individually, exactly as with `enqueue_dynamic()`.
+  template <typename T>
+  auto enqueue_batch(std::vector<request> reqs)
+    -> std::vector<std::shared_ptr<pending_dynamic_response<T>>>;
+
   /// Internal enqueue implementation (type-erased).
   /// MUST be called from connection strand.
   auto enqueue_impl(request req, std::shared_ptr<response_sink> sink,
                     std::chrono::steady_clock::time_point start) -> void;
 
+  /// Admit one request into the pipeline (or fail its sink) without waking the loops.
+  /// Returns true when the request was queued. MUST be called from connection strand.
+  auto admit(request req, std::shared_ptr<response_sink> sink,
+             std::chrono::steady_clock::time_point start) -> bool;
+
   /// Get current connection state (for diagnostics).
   [[nodiscard]] auto state() const noexcept -> connection_state {
     return state_snapshot_.load(std::memory_order_acquire);
   }
 
+  /// Snapshot of the built-in counters. Thread-safety: any thread (relaxed atomic reads).
+  [[nodiscard]] auto stats() const noexcept -> connection_stats { return metrics_.snapshot(); }
+
+  /// Slow requests recorded so far, oldest first (empty unless `config::slow_requests` is
+  /// enabled). Thread-safety: any thread.
+  [[nodiscard]] auto slow_requests() const -> std::vector<slow_request_record> {
+    return slow_log_ != nullptr ? slow_log_->snapshot() : std::vector<slow_request_record>{};
+  }
+
+  /// Budget `config::adaptive_timeout` currently derives for `verb` (nullopt while the verb falls
+  /// back to `request_timeout`, or when disabled). Resumes on the connection strand.
+  auto adaptive_timeout_for(std::string verb)
+    -> iocoro::awaitable<std::optional<std::chrono::nanoseconds>>;
+
  private:
   /// Start the background connection actor (internal use only).
   ///
@@ -135,7 +190,7 @@ class connection : public std::enable_shared_from_this<connection> {
   /// - write_loop(): flushes pending pipeline writes when `state_ == OPEN`
   /// - read_loop(): performs socket reads when `state_ == OPEN` and delivers parsed messages;
   ///   unsolicited server messages (e.g. PUSH) are treated as an error for now
-  /// - control_loop(): owns reconnection/backoff and request-timeout enforcement
+  /// - control_loop(): owns reconnection/backoff, request-timeout enforcement and health checks
   ///
   /// Concurrency constraints (MUST hold):
   /// - All three loops run on the same strand (no parallel executors)
@@ -161,6 +216,11 @@ class connection : public std::enable_shared_from_this<connection> {
   /// Woken by: handle_error(), connect()/handshake completion, close(), timers.
   auto control_loop() -> iocoro::awaitable<void>;
 
+  /// Standby loop: keeps a handshaked standby connection ready while `OPEN` (no-op unless
+  /// `standby_options::enabled`).
+  /// Woken by: state transitions (promotion consumes the standby), close/cancel.
+  auto standby_loop() -> iocoro::awaitable<void>;
+
   /// Connect to Redis server with timeout and retry.
   /// After TCP connection succeeds, sends handshake commands:
   /// - HELLO 3 (switch to RESP3)
@@ -176,6 +236,61 @@ class connection : public std::enable_shared_from_this<connection> {
   /// - unexpected(error_info): connection failed with specific error
   auto do_connect() -> iocoro::awaitable<expected<void, error_info>>;
 
+  /// Resolve `cfg_.host:cfg_.port` (getaddrinfo on a background thread, bounded by
+  /// `resolve_timeout`).
+  auto resolve() -> iocoro::awaitable<expected<std::vector<iocoro::ip::tcp::endpoint>, error_info>>;
+
+  /// `resolve()` without touching the connection (parameters are owned by the coroutine frame).
+  static auto resolve_host(std::string host, int port,
+                           std::optional<std::chrono::milliseconds> timeout)
+    -> iocoro::awaitable<expected<std::vector<iocoro::ip::tcp::endpoint>, error_info>>;
+
+  /// Endpoints for the next connect attempt, in connect order.
+  ///
+  /// With `endpoint_cache` enabled, serves cached endpoints (spawning a background refresh once
+  /// they are stale) and only resolves synchronously on a miss. Sets `from_cache` accordingly.
+  auto resolve_endpoints(bool& from_cache)
+    -> iocoro::awaitable<expected<std::vector<iocoro::ip::tcp::endpoint>, error_info>>;
+
+  /// Background refresh of the endpoint cache (spawned by `resolve_endpoints()` under `stop_`).
+  ///
+  /// Holds the connection only weakly while resolving; a connection destroyed meanwhile
+  /// discards the result.
+  static auto refresh_endpoints(std::weak_ptr<connection> weak, std::string host, int port,
+                                std::optional<std::chrono::milliseconds> timeout)
+    -> iocoro::awaitable<void>;
+
+  /// TCP-connect `out` to the first endpoint that accepts, applying socket options.
+  /// Attempts are staggered by `connect_attempt_delay` and race each other; the winner's socket
+  /// becomes `out`.
+  auto connect_endpoints(std::vector<iocoro::ip::tcp::endpoint> const& endpoints,
+                         iocoro::ip::tcp::socket& out)
+    -> iocoro::awaitable<expected<void, error_info>>;
+
+  /// Close the sockets of every connect race in progress (used by `close()`): their attempts
+  /// fail right away instead of waiting for `connect_timeout`.
+  auto cancel_connect_races() -> void;
+
+  /// HELLO 3 plus AUTH / SELECT / CLIENT SETNAME as configured.
+  [[nodiscard]] auto make_handshake_request() const -> request;
+
+  /// Drive the handshake IO on `sock` (the handshake request is already queued in `pl`) and
+  /// validate the replies collected in `slot`. Bounded by `request_timeout`, else
+  /// `connect_timeout`. Does not fail the pipeline on error (caller's policy).
+  auto run_handshake(iocoro::ip::tcp::socket& sock, pipeline& pl, resp3::parser& parser,
+                     std::shared_ptr<pending_dynamic_response<ignore_t>> slot)
+    -> iocoro::awaitable<expected<void, error_info>>;
+
+  /// Transition to `OPEN` after a successful handshake or failover: bumps the generation, emits
+  /// connected, and releases deferred requests.
+  auto enter_open(connection_event_stage stage, std::string_view reason) -> void;
+
+  /// Connect and handshake `standby_socket_` (see `standby_options`).
+  auto open_standby() -> iocoro::awaitable<expected<void, error_info>>;
+
+  /// Replace the failed socket with the ready standby and enter `OPEN` (from `FAILED`).
+  auto promote_standby() -> iocoro::awaitable<void>;
+
   /// Read and parse RESP3 messages from socket.
   ///
   /// Implementation:
@@ -184,13 +299,27 @@ class connection : public std::enable_shared_from_this<connection> {
   /// - Delivers messages into the pipeline in FIFO order; if there is no pending read, the message
   ///   is treated as unsolicited and triggers a runtime error path.
   /// - Leaves partial data in the parser for the next call.
+  /// - With `read_spin` enabled and replies outstanding, polls the socket for up to the spin
+  ///   budget (`spin_read()`) before falling back to `async_read_some`.
+  /// - With `read_ahead` enabled, keeps reading without blocking after each parse pass while
+  ///   replies are outstanding and bytes are available (bounded by `read_ahead.max_reads`).
   auto do_read() -> iocoro::awaitable<void>;
 
+  /// Commit a completed socket read into the parser.
+  /// Returns false after routing a read error / EOF to `handle_error()` (or on shutdown).
+  auto on_read_complete(iocoro::result<std::size_t> const& r) -> bool;
+
+  /// Busy-poll the socket with non-blocking reads into `buf` for up to `read_spin.budget`.
+  /// Returns would_block when spinning is disabled, no reply is pending, or the budget ran out.
+  auto spin_read(std::span<std::byte> buf) -> nonblocking_read_result;
+
   /// Write pending requests to socket.
   ///
   /// Implementation:
   /// - While `state_ == OPEN` and pipeline has pending writes, repeatedly writes some bytes
   ///   (`async_write_some`) and advances the pipeline via `pipeline_.on_write_done()`.
+  /// - With auto-pipelining enabled, each write may cover several queued requests (see
+  ///   `pipeline::write_options`).
   /// - On successful writes that make reads pending, wakes the read loop.
   auto do_write() -> iocoro::awaitable<void>;
 
@@ -198,13 +327,24 @@ class connection : public std::enable_shared_from_this<connection> {
   ///
   /// Behavior (runtime-only):
   /// - Idempotent guard: ignores errors while already `FAILED`/`RECONNECTING`/`CLOSING`/`CLOSED`.
-  /// - Transitions `OPEN -> FAILED`, emits a disconnected event, clears the pipeline, and closes
-  ///   socket.
+  /// - Transitions `OPEN -> FAILED`, emits a disconnected event, clears (or, with offline
+  ///   buffering, parks) the pipeline, and closes socket.
   /// - Reconnection (or deterministic shutdown when disabled) is driven by `control_loop()`.
   ///
   /// Thread-safety: MUST be called from connection strand only
   auto handle_error(error_info ec) -> void;
 
+  /// Offline buffering is active (`config::offline_buffer` with reconnection enabled).
+  [[nodiscard]] auto offline_buffering() const noexcept -> bool {
+    return cfg_.offline_buffer.enabled && cfg_.reconnection.enabled;
+  }
+
+  /// Fail the pipeline after a connection loss, keeping what offline buffering can replay.
+  auto fail_pipeline(error_info const& err) -> void;
+
+  /// Fail buffered requests whose `request_timeout` elapsed while disconnected.
+  auto expire_offline_requests() -> void;
+
   /// Perform reconnection loop with exponential backoff.
   ///
   /// Called by `control_loop()` when `state_ == FAILED` and reconnection is enabled:
@@ -225,8 +365,48 @@ class connection : public std::enable_shared_from_this<connection> {
   auto emit_connection_event(connection_event evt) noexcept -> void;
 
   auto set_state(connection_state next) noexcept -> void {
+    REDISCORO_PROBE3(state__change, this, static_cast<int>(state_), static_cast<int>(next));
     state_ = next;
     state_snapshot_.store(next, std::memory_order_release);
+    if (cfg_.standby.enabled) {
+      standby_wakeup_.notify();
+    }
+  }
+
+  /// True when requests need their submission time: anything measuring a request's duration
+  /// (tracing, latency recorder, slow-request log, adaptive timeouts) reads it as the start.
+  [[nodiscard]] auto stamps_submission() const noexcept -> bool {
+    return cfg_.trace_hooks.enabled() || cfg_.latency != nullptr || slow_log_ != nullptr ||
+           adaptive_timeout_ != nullptr;
+  }
+
+  /// True when requests carry phase timestamps (phase tracing or the slow-request log).
+  [[nodiscard]] auto stamps_phases() const noexcept -> bool {
+    return cfg_.trace_hooks.on_phases != nullptr || slow_log_ != nullptr;
+  }
+
+  /// True when requests may carry deadlines (`request_timeout` or `adaptive_timeout`).
+  [[nodiscard]] auto enforces_deadlines() const noexcept -> bool {
+    return cfg_.request_timeout.has_value() || adaptive_timeout_ != nullptr;
+  }
+
+  /// Log the slow requests recorded since the previous dump, if
+  /// `slow_request_options::dump_on_disconnect` is set. Called wherever the connection is lost
+  /// or closed (runtime error, actor failure, failed connect, `close()`).
+  auto dump_slow_requests() -> void;
+
+  /// Health-check step run by `control_loop()` while OPEN (`health_check_options`): sends a PING
+  /// once the connection is idle, fails it when a PING outlives the timeout. Returns when the
+  /// next step is due.
+  auto health_tick() -> pipeline::time_point;
+
+  /// Fold the round trip of the completed health-check PING into the stats.
+  auto finish_health_probe() noexcept -> void;
+
+  /// Publish the pipeline gauges (queue depth, pending write bytes) to `metrics_`.
+  auto update_queue_gauges() noexcept -> void {
+    metrics_.queue_depth.set(pipeline_.pending_count());
+    metrics_.pending_write_bytes.set(pipeline_.pending_write_bytes());
   }
 
  private:
@@ -236,20 +416,48 @@ class connection : public std::enable_shared_from_this<connection> {
   // Executor management
   connection_executor executor_;
 
+  // Inline waiter resumption (`config::inline_resume`). Declared before pipeline_ so it outlives
+  // the sinks failed during destruction.
+  resume_queue resumer_;
+
   // Socket
   iocoro::ip::tcp::socket socket_;
 
+  // Resolved endpoints reused across connects (strand-only).
+  endpoint_cache<iocoro::ip::tcp::endpoint> endpoint_cache_;
+
+  // Connect races in progress (main and standby may race at once; strand-only).
+  std::vector<std::shared_ptr<connect_race>> connect_races_{};
+
   // State machine
   connection_state state_{connection_state::INIT};
   std::atomic<connection_state> state_snapshot_{connection_state::INIT};
   std::uint64_t generation_{0};  // Increments on each successful OPEN transition.
 
+  // Slow-request flight recorder (null unless enabled). Declared before pipeline_ so it outlives
+  // the sinks failed during destruction.
+  std::unique_ptr<slow_request_log> slow_log_{};
+  std::uint64_t slow_log_dumped_{0};  // slow_log_->total() at the last dump (strand-only)
+
+  // Latency model of `config::adaptive_timeout` (null unless enabled). Declared before pipeline_
+  // so its histograms outlive the sinks failed during destruction.
+  std::unique_ptr<adaptive_timeout> adaptive_timeout_{};
+
+  // Identical in-flight read deduplication. Declared before pipeline_ so it outlives the
+  // fan-out sinks the pipeline may still hold during destruction.
+  singleflight_group singleflight_;
+
   // Request/response pipeline
   pipeline pipeline_;
 
   // RESP3 parser
   resp3::parser parser_{};
 
+  // Set when the parser buffer may hold complete replies not parsed yet (the handshake read past
+  // its own replies, or stream backpressure paused parsing); the next do_read() parses them
+  // before reading from the socket (strand-only).
+  bool parse_buffered_{false};
+
   // Lifecycle cancellation scope (resettable).
   stop_scope stop_{};
 
@@ -261,6 +469,12 @@ class connection : public std::enable_shared_from_this<connection> {
   // IO in-flight guards (strand-only mutation)
   bool read_in_flight_{false};
   bool write_in_flight_{false};
+  iocoro::condition_event io_idle_{};  // notified when an in-flight read/write finishes
+
+  // Warm standby (strand-only): handshaked and idle while standby_ready_.
+  iocoro::ip::tcp::socket standby_socket_;
+  bool standby_ready_{false};
+  iocoro::condition_event standby_wakeup_{};
 
   // Actor lifecycle
   bool actor_running_{false};
@@ -269,8 +483,18 @@ class connection : public std::enable_shared_from_this<connection> {
   // Reconnection state
   int reconnect_count_{0};  // Number of reconnection attempts (reset on success)
 
+  // Health checking (strand-only).
+  std::shared_ptr<health_probe_sink> health_probe_{};  // outstanding PING, if any
+  std::uint64_t health_seen_messages_{0};               // messages_parsed at the last step
+  pipeline::time_point health_idle_since_{};            // last observed progress
+  std::chrono::nanoseconds ping_rtt_ewma_{0};
+
   // Tracing / diagnostics
   std::uint64_t next_request_id_{1};
+  std::uint64_t trace_sample_count_{0};  // sampling position (trace_hooks.sample_every)
+  std::uint64_t key_sample_count_{0};    // sampling position (key_tracking)
+  pipeline::time_point last_read_at_{};  // completion of the latest socket read (phase tracing)
+  connection_metrics metrics_{};  // written on the strand, read by stats() from any thread
 };
 
 }  // namespace rediscoro::detail
@@ -16,10 +16,15 @@ namespace rediscoro::detail {
 ///   concurrently (the connection enforces the per-direction rule).
 /// - Connection code must not bypass the strand by awaiting/spawning on other executors.
 /// - The strand handle is stable/copyable (copies refer to the same strand).
+/// - With `single_threaded` (see `config::single_threaded`) the io executor itself serves as the
+///   strand: a single-threaded io_context already serializes every handler, so no strand
+///   dispatch (and none of its atomics) is paid on enqueue and completion.
 class connection_executor {
  public:
-  explicit connection_executor(iocoro::any_io_executor ex)
-      : io_executor_(ex), strand_(iocoro::make_strand(iocoro::any_executor{ex})) {}
+  explicit connection_executor(iocoro::any_io_executor ex, bool single_threaded = false)
+      : io_executor_(ex),
+        strand_(single_threaded ? iocoro::any_executor{ex}
+                                : iocoro::make_strand(iocoro::any_executor{ex})) {}
 
   /// Strand executor façade.
   ///
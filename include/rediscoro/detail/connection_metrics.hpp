@@ -0,0 +1,79 @@
+#pragma once
+
+#include <rediscoro/stats.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace rediscoro::detail {
+
+/// Counter written by a single thread (the connection strand) and read from any thread.
+///
+/// Updates are a relaxed load + store rather than a read-modify-write: with one writer no
+/// increment can be lost, and the hot path never pays for a locked instruction.
+class metric {
+ public:
+  auto add(std::uint64_t n = 1) noexcept -> void {
+    value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  auto set(std::uint64_t v) noexcept -> void { value_.store(v, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto load() const noexcept -> std::uint64_t {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<std::uint64_t> value_{0};
+};
+
+/// Built-in per-connection counters and gauges (see `connection_stats`).
+///
+/// Thread-safety: updates on the connection strand only; `snapshot()` from any thread.
+struct connection_metrics {
+  metric bytes_read{};
+  metric bytes_written{};
+  metric read_ops{};
+  metric write_ops{};
+  metric messages_parsed{};
+  metric requests_accepted{};
+  metric requests_rejected{};
+  metric queue_full_rejections{};
+  metric requests_deduplicated{};
+  metric timeouts{};
+  metric connects{};
+  metric reconnects{};
+  metric disconnects{};
+  metric health_checks{};
+  metric health_check_failures{};
+  metric ping_rtt_us{};
+  metric ping_rtt_ewma_us{};
+  metric queue_depth{};
+  metric pending_write_bytes{};
+
+  [[nodiscard]] auto snapshot() const noexcept -> connection_stats {
+    return connection_stats{
+      .bytes_read = bytes_read.load(),
+      .bytes_written = bytes_written.load(),
+      .read_ops = read_ops.load(),
+      .write_ops = write_ops.load(),
+      .messages_parsed = messages_parsed.load(),
+      .requests_accepted = requests_accepted.load(),
+      .requests_rejected = requests_rejected.load(),
+      .queue_full_rejections = queue_full_rejections.load(),
+      .requests_deduplicated = requests_deduplicated.load(),
+      .timeouts = timeouts.load(),
+      .connects = connects.load(),
+      .reconnects = reconnects.load(),
+      .disconnects = disconnects.load(),
+      .health_checks = health_checks.load(),
+      .health_check_failures = health_check_failures.load(),
+      .ping_rtt_us = ping_rtt_us.load(),
+      .ping_rtt_ewma_us = ping_rtt_ewma_us.load(),
+      .queue_depth = queue_depth.load(),
+      .pending_write_bytes = pending_write_bytes.load(),
+    };
+  }
+};
+
+}  // namespace rediscoro::detail
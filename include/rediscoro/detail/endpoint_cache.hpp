@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rediscoro::detail {
+
+/// Resolved-endpoint cache with TTL (stale-while-revalidate).
+///
+/// Semantics:
+/// - `lookup()` returns the cached endpoints while any are cached, flagging them stale once the
+///   TTL has elapsed. Callers connect with stale endpoints right away and refresh in the
+///   background instead of paying DNS latency on the connect path.
+/// - `invalidate()` drops the entry (e.g. every cached endpoint refused connections), forcing
+///   the next connect to resolve synchronously.
+/// - With `prefer_last`, the endpoint of the last successful connect is ordered first.
+///
+/// Templated on the endpoint type so it can be tested without sockets.
+/// Thread-safety: not thread-safe (connection strand only).
+template <typename Endpoint>
+class endpoint_cache {
+ public:
+  using clock = std::chrono::steady_clock;
+  using time_point = clock::time_point;
+
+  struct entry {
+    std::vector<Endpoint> endpoints{};
+    bool stale = false;
+  };
+
+  endpoint_cache() = default;
+  endpoint_cache(std::chrono::milliseconds ttl, bool prefer_last)
+      : ttl_(ttl), prefer_last_(prefer_last) {}
+
+  /// Cached endpoints in connect order, or nullopt when nothing is cached.
+  [[nodiscard]] auto lookup(time_point now) const -> std::optional<entry> {
+    if (endpoints_.empty()) {
+      return std::nullopt;
+    }
+    return entry{.endpoints = order(endpoints_), .stale = now >= expires_at_};
+  }
+
+  /// Replace the cached endpoints (empty results are ignored: keep serving the old ones).
+  auto store(std::vector<Endpoint> endpoints, time_point now) -> void {
+    if (endpoints.empty()) {
+      return;
+    }
+    endpoints_ = std::move(endpoints);
+    expires_at_ = now + ttl_;
+  }
+
+  auto invalidate() noexcept -> void { endpoints_.clear(); }
+
+  /// Record the endpoint of a successful connect (kept across invalidate()/store()).
+  auto remember_success(Endpoint const& ep) -> void { last_success_ = ep; }
+
+  /// Order freshly resolved endpoints for connecting (last successful endpoint first).
+  [[nodiscard]] auto order(std::vector<Endpoint> endpoints) const -> std::vector<Endpoint> {
+    if (!prefer_last_ || !last_success_.has_value()) {
+      return endpoints;
+    }
+    auto it = std::ranges::find(endpoints, *last_success_);
+    if (it != endpoints.end()) {
+      std::rotate(endpoints.begin(), it, it + 1);
+    }
+    return endpoints;
+  }
+
+  /// Background refresh bookkeeping: at most one refresh runs at a time.
+  [[nodiscard]] auto try_begin_refresh() noexcept -> bool {
+    if (refreshing_) {
+      return false;
+    }
+    refreshing_ = true;
+    return true;
+  }
+  auto end_refresh() noexcept -> void { refreshing_ = false; }
+
+ private:
+  std::chrono::milliseconds ttl_{0};
+  bool prefer_last_ = true;
+  std::vector<Endpoint> endpoints_{};
+  time_point expires_at_{};
+  std::optional<Endpoint> last_success_{};
+  bool refreshing_ = false;
+};
+
+}  // namespace rediscoro::detail
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace rediscoro::detail {
+
+/// 64-bit FNV-1a: cheap, stable across runs and platforms (unlike `std::hash`).
+[[nodiscard]] constexpr auto fnv1a_64(std::string_view s) noexcept -> std::uint64_t {
+  std::uint64_t h = 14695981039346656037ULL;
+  for (char c : s) {
+    h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return h;
+}
+
+}  // namespace rediscoro::detail
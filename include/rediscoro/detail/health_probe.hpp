@@ -0,0 +1,46 @@
+#pragma once
+
+#include <rediscoro/detail/response_sink.hpp>
+#include <rediscoro/error_info.hpp>
+#include <rediscoro/resp3/message.hpp>
+
+#include <chrono>
+
+namespace rediscoro::detail {
+
+/// Sink of an internal health-check PING (see `health_check_options`).
+///
+/// Any reply, even an error reply, proves the peer alive; the connection reads the outcome once
+/// the sink completes. Thread-safety: connection strand only.
+class health_probe_sink final : public response_sink {
+ public:
+  using time_point = std::chrono::steady_clock::time_point;
+
+  explicit health_probe_sink(time_point sent_at) noexcept : sent_at_(sent_at) {}
+
+  [[nodiscard]] bool is_complete() const noexcept override { return done_; }
+
+  [[nodiscard]] auto sent_at() const noexcept -> time_point { return sent_at_; }
+
+  /// True when a reply arrived (false when the PING was failed locally, e.g. on disconnect).
+  [[nodiscard]] auto answered() const noexcept -> bool { return replied_at_ != time_point{}; }
+
+  [[nodiscard]] auto rtt() const noexcept -> std::chrono::nanoseconds {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(replied_at_ - sent_at_);
+  }
+
+ protected:
+  void do_deliver(resp3::message) override {
+    replied_at_ = std::chrono::steady_clock::now();
+    done_ = true;
+  }
+
+  void do_deliver_error(error_info) override { done_ = true; }
+
+ private:
+  time_point sent_at_;
+  time_point replied_at_{};
+  bool done_{false};
+};
+
+}  // namespace rediscoro::detail
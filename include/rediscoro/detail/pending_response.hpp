@@ -3,11 +3,11 @@
 #include <rediscoro/assert.hpp>
 #include <rediscoro/detail/response_builder.hpp>
 #include <rediscoro/detail/response_sink.hpp>
+#include <rediscoro/detail/resume_queue.hpp>
 #include <rediscoro/error_info.hpp>
 #include <rediscoro/response.hpp>
 
 #include <iocoro/awaitable.hpp>
-#include <iocoro/condition_event.hpp>
 
 #include <chrono>
 #include <optional>
@@ -24,6 +24,7 @@ namespace rediscoro::detail {
 /// - wait() is called from user's coroutine context (any executor)
 /// - No cross-executor synchronization needed for deliver
 /// - condition_event handles executor dispatch for wait() resumption
+///   (or, with `config::inline_resume`, the connection resumes the waiter after the read batch)
 ///
 /// Why this simplification is safe:
 /// - pipeline runs on connection strand
@@ -49,8 +50,14 @@ class pending_response final : public response_sink {
 
   [[nodiscard]] bool is_complete() const noexcept override { return result_.has_value(); }
 
+  /// Resume the waiter inline through `q` (see `config::inline_resume`). Call before wait().
+  auto set_resume_queue(resume_queue* q) noexcept -> void { signal_.use_inline(q); }
+
   auto wait() -> iocoro::awaitable<response<Ts...>> {
-    (void)co_await event_.async_wait();
+    co_await signal_.wait();
+    if (wants_phases()) {
+      emit_trace_phases(std::chrono::steady_clock::now());
+    }
     REDISCORO_ASSERT(result_.has_value());
     co_return std::move(*result_);
   }
@@ -66,7 +73,7 @@ class pending_response final : public response_sink {
     if (builder_.done()) {
       result_ = builder_.take_results();
       emit_trace_finish_if_needed(*result_);
-      event_.notify();
+      signal_.notify();
     }
   }
 
@@ -80,12 +87,12 @@ class pending_response final : public response_sink {
     if (builder_.done()) {
       result_ = builder_.take_results();
       emit_trace_finish_if_needed(*result_);
-      event_.notify();
+      signal_.notify();
     }
   }
 
  private:
-  iocoro::condition_event event_{};
+  completion_signal signal_{};
   response_builder<Ts...> builder_{};
   std::optional<response<Ts...>> result_{};
 
@@ -131,8 +138,14 @@ class pending_dynamic_response final : public response_sink {
 
   [[nodiscard]] bool is_complete() const noexcept override { return result_.has_value(); }
 
+  /// Resume the waiter inline through `q` (see `config::inline_resume`). Call before wait().
+  auto set_resume_queue(resume_queue* q) noexcept -> void { signal_.use_inline(q); }
+
   auto wait() -> iocoro::awaitable<dynamic_response<T>> {
-    (void)co_await event_.async_wait();
+    co_await signal_.wait();
+    if (wants_phases()) {
+      emit_trace_phases(std::chrono::steady_clock::now());
+    }
     REDISCORO_ASSERT(result_.has_value());
     co_return std::move(*result_);
   }
@@ -148,7 +161,7 @@ class pending_dynamic_response final : public response_sink {
     if (builder_.done()) {
       result_ = builder_.take_results();
       emit_trace_finish_if_needed(*result_);
-      event_.notify();
+      signal_.notify();
     }
   }
 
@@ -162,12 +175,12 @@ class pending_dynamic_response final : public response_sink {
     if (builder_.done()) {
       result_ = builder_.take_results();
       emit_trace_finish_if_needed(*result_);
-      event_.notify();
+      signal_.notify();
     }
   }
 
  private:
-  iocoro::condition_event event_{};
+  completion_signal signal_{};
   dynamic_response_builder<T> builder_;
   std::optional<dynamic_response<T>> result_{};
 
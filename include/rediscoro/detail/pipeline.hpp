@@ -43,8 +43,20 @@ class pipeline {
     std::size_t max_pending_write_bytes = 64ULL * 1024ULL * 1024ULL;  // 64 MiB
   };
 
+  /// Write coalescing (auto-pipelining).
+  ///
+  /// When enabled, `next_write_buffer()` gathers the wire bytes of several queued requests into a
+  /// single contiguous buffer so they can be flushed with one socket write. Each request keeps its
+  /// own sink and moves to the awaiting queue independently as its bytes are acknowledged.
+  struct write_options {
+    bool coalesce = false;
+    std::size_t max_batch_bytes = 64ULL * 1024ULL;  // 64 KiB
+    std::size_t max_batch_requests = 1024U;
+  };
+
   pipeline() = default;
   explicit pipeline(limits lims) : limits_(lims) {}
+  pipeline(limits lims, write_options wopts) : limits_(lims), write_options_(wopts) {}
 
   using clock = std::chrono::steady_clock;
   using time_point = clock::time_point;
@@ -63,8 +75,58 @@ class pipeline {
   /// Enqueue a request with a timeout deadline.
   ///
   /// deadline == time_point::max() means "no timeout".
+  /// `replayable` marks an idempotent request that `park()` may send again even after it was
+  /// written (its wire bytes are then retained until the replies arrive).
+  /// Returns false if queue limits are exceeded.
+  auto push(request req, std::shared_ptr<response_sink> sink, time_point deadline,
+            bool replayable = false) -> bool;
+
+  /// Enqueue a request owned by the connection itself (handshake, health-check PING).
+  ///
+  /// Not subject to the queue limits, which bound user requests: a full deferred queue must not
+  /// keep the connection from being (re)established. Never parked by `park()`: it belongs to
+  /// the connection it was queued on and is failed with it.
+  auto push_internal(request req, std::shared_ptr<response_sink> sink) -> void;
+
+  /// Hold a request back until `release_deferred()` (requests submitted while connecting).
+  ///
+  /// Deferred requests count towards the queue limits but are not writable yet, so a handshake
+  /// pushed later is still written first.
   /// Returns false if queue limits are exceeded.
-  auto push(request req, std::shared_ptr<response_sink> sink, time_point deadline) -> bool;
+  auto defer(request req, std::shared_ptr<response_sink> sink, time_point deadline,
+             bool replayable = false) -> bool;
+
+  /// Move all deferred requests (in submission order) behind the pending writes.
+  auto release_deferred() -> void;
+
+  /// Check if there are deferred requests.
+  [[nodiscard]] bool has_deferred() const noexcept { return !deferred_.empty(); }
+
+  /// Number and wire bytes of deferred requests.
+  [[nodiscard]] std::size_t deferred_count() const noexcept { return deferred_.size(); }
+  [[nodiscard]] std::size_t deferred_bytes() const noexcept { return deferred_bytes_; }
+
+  /// Keep requests across a connection loss (offline buffering).
+  ///
+  /// Moves every request that can safely be sent again on a new connection to the deferred
+  /// queue, in original order:
+  /// - written but unanswered requests marked replayable (and not partially answered);
+  /// - requests not (fully) written: a partially written command is discarded by the server
+  ///   when the old connection dies;
+  /// - requests already deferred.
+  /// Everything else (internal requests included), and everything beyond `max_requests` /
+  /// `max_bytes`, fails with `err`.
+  /// Returns the number of deferred requests.
+  auto park(error_info const& err, std::size_t max_requests, std::size_t max_bytes)
+    -> std::size_t;
+
+  /// Fail every written request still awaiting replies with `err`, so a later `park()` cannot
+  /// replay it. Returns the number of failed requests.
+  auto fail_awaiting(error_info const& err) -> std::size_t;
+
+  /// Fail deferred requests whose deadline is at or before `now`.
+  /// Returns the number of failed requests.
+  auto fail_expired_deferred(time_point now, error_info const& err) -> std::size_t;
 
   /// Check if there are pending writes.
   [[nodiscard]] bool has_pending_write() const noexcept;
@@ -74,12 +136,35 @@ class pipeline {
 
   /// Get the next buffer to write.
   /// Precondition: has_pending_write() == true
+  ///
+  /// With write coalescing enabled, the returned view may span several requests (starting at the
+  /// front request). The view stays valid until the next `on_write_done()` / `clear_all()`.
   [[nodiscard]] auto next_write_buffer() -> std::string_view;
 
   /// Mark N bytes as written.
+  /// N must not exceed the size of the last `next_write_buffer()` view.
   /// When a request is fully written, it moves to the awaiting queue.
   auto on_write_done(std::size_t n) -> void;
 
+  /// Phase tracing: stamp each request's `written` time as its last byte is written (see
+  /// `request_trace_hooks::on_phases`).
+  auto set_phase_stamping(bool enabled) noexcept -> void { stamp_phases_ = enabled; }
+
+  /// Phase tracing: the reply about to be passed to `on_message()` was read at `read_at` and
+  /// parsed at `parsed_at`.
+  auto stamp_reply(time_point read_at, time_point parsed_at) noexcept -> void {
+    if (!awaiting_read_.empty()) {
+      awaiting_read_.front().sink->stamp_reply(read_at, parsed_at);
+    }
+  }
+
+  /// Key tracking: the reply about to be passed to `on_message()` is `n` bytes on the wire.
+  auto add_reply_bytes(std::size_t n) noexcept -> void {
+    if (!awaiting_read_.empty()) {
+      awaiting_read_.front().sink->add_reply_bytes(n);
+    }
+  }
+
   /// Dispatch a received RESP3 message to the next pending response.
   /// Precondition: has_pending_read() == true
   auto on_message(resp3::message msg) -> void;
@@ -88,22 +173,33 @@ class pipeline {
   /// Precondition: has_pending_read() == true
   auto on_error(error_info err) -> void;
 
-  /// Clear all pending requests (on connection close/error).
+  /// True when the sink awaiting the next reply asks the reader to pause (consumer backpressure).
+  [[nodiscard]] auto read_paused() const noexcept -> bool {
+    return !awaiting_read_.empty() && awaiting_read_.front().sink->saturated();
+  }
+
+  /// Clear all pending requests, deferred ones included (on connection close/error).
   auto clear_all(error_info err) -> void;
 
   /// Earliest deadline among all pending requests.
   /// Returns time_point::max() if there is no deadline.
   [[nodiscard]] auto next_deadline() const noexcept -> time_point;
 
+  /// Latest deadline at the back of the queues (time_point::min() if there is none).
+  ///
+  /// `next_deadline()` only looks at the queue fronts, so a request queued behind a later
+  /// deadline is not checked until that one leaves; per-request budgets are raised to this.
+  [[nodiscard]] auto last_deadline() const noexcept -> time_point;
+
   /// True if the earliest pending request has reached its deadline.
   [[nodiscard]] bool has_expired() const noexcept;
 
   /// Get the number of pending requests (for diagnostics).
   [[nodiscard]] std::size_t pending_count() const noexcept {
-    return pending_write_.size() + awaiting_read_.size();
+    return deferred_.size() + pending_write_.size() + awaiting_read_.size();
   }
 
-  /// Get pending (not-yet-written) wire bytes.
+  /// Get pending (not-yet-written) wire bytes, deferred requests included.
   [[nodiscard]] std::size_t pending_write_bytes() const noexcept { return pending_write_bytes_; }
 
  private:
@@ -112,13 +208,22 @@ class pipeline {
     std::shared_ptr<response_sink> sink;  // Abstract interface, no knowledge of coroutines
     std::size_t written{0};               // bytes written so far
     time_point deadline{time_point::max()};
+    bool replayable{false};
+    bool internal{false};  // connection-owned (`push_internal()`)
   };
 
   struct awaiting_item {
     std::shared_ptr<response_sink> sink;  // Abstract interface
     time_point deadline{time_point::max()};
+    request req{};  // retained only when replayable
+    bool replayable{false};
+    bool partial{false};  // some (not all) replies delivered
+    bool internal{false};
   };
 
+  // Requests held back until release_deferred()
+  ring_queue<pending_item> deferred_{};
+
   // Requests waiting to be written to socket
   ring_queue<pending_item> pending_write_{};
 
@@ -126,7 +231,26 @@ class pipeline {
   ring_queue<awaiting_item> awaiting_read_{};
 
   limits limits_{};
+  write_options write_options_{};
   std::size_t pending_write_bytes_{0};
+  std::size_t deferred_bytes_{0};
+  bool stamp_phases_{false};
+
+  // Coalesced write buffer (auto-pipelining). Holds a copy of the unwritten wire bytes of the
+  // first K pending requests; `write_batch_offset_` tracks how much of it has been written.
+  std::string write_batch_{};
+  std::size_t write_batch_offset_{0};
+
+  [[nodiscard]] auto fits_limits(std::size_t wire_bytes) const noexcept -> bool;
+
+  [[nodiscard]] bool has_write_batch() const noexcept {
+    return write_batch_offset_ < write_batch_.size();
+  }
+
+  auto reset_write_batch() noexcept -> void {
+    write_batch_.clear();
+    write_batch_offset_ = 0;
+  }
 };
 
 }  // namespace rediscoro::detail
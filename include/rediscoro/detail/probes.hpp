@@ -0,0 +1,32 @@
+#pragma once
+
+/// USDT (user statically defined tracing) probes for bpftrace / perf / SystemTap.
+///
+/// Compiled to nothing unless `REDISCORO_ENABLE_USDT` is defined to a non-zero value (CMake
+/// option of the same name), in which case <sys/sdt.h> must be available. An enabled probe costs
+/// a NOP plus having its (cheap, integer) arguments in registers; nothing else runs until a
+/// tracer attaches. All probes fire on the connection strand and pass the connection first.
+///
+/// Provider `rediscoro`:
+/// - enqueue(conn, wire_bytes, command_count): request reached admission
+/// - reject(conn, error_value): request rejected at admission
+/// - write__done(conn, bytes): socket write completed
+/// - parse(conn, message_bytes): one reply parsed
+/// - deliver(conn, pending_requests): reply handed to the pipeline
+/// - reconnect(conn, attempt, delay_ms): reconnect attempt scheduled
+/// - state__change(conn, from, to): `connection_state` transition
+///
+/// Example: `bpftrace -e 'usdt:./app:rediscoro:write__done { @bytes = hist(arg1); }'`
+
+#if defined(REDISCORO_ENABLE_USDT) && REDISCORO_ENABLE_USDT
+#if !__has_include(<sys/sdt.h>)
+#error "REDISCORO_ENABLE_USDT requires <sys/sdt.h> (e.g. systemtap-sdt-dev)"
+#endif
+#include <sys/sdt.h>
+
+#define REDISCORO_PROBE2(name, a1, a2) DTRACE_PROBE2(rediscoro, name, a1, a2)
+#define REDISCORO_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(rediscoro, name, a1, a2, a3)
+#else
+#define REDISCORO_PROBE2(name, a1, a2) ((void)0)
+#define REDISCORO_PROBE3(name, a1, a2, a3) ((void)0)
+#endif
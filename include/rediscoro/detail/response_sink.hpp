@@ -1,16 +1,42 @@
 #pragma once
 
 #include <rediscoro/assert.hpp>
+#include <rediscoro/detail/command_info.hpp>
 #include <rediscoro/error_info.hpp>
+#include <rediscoro/key_tracker.hpp>
+#include <rediscoro/latency_recorder.hpp>
 #include <rediscoro/logger.hpp>
 #include <rediscoro/resp3/message.hpp>
+#include <rediscoro/slow_request_log.hpp>
 #include <rediscoro/tracing.hpp>
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 
 namespace rediscoro::detail {
 
+/// A request sampled for `key_tracker`: its verb and first key (copied from the wire bytes).
+struct key_sample {
+  key_tracker* tracker{nullptr};
+  std::string command{};
+  std::string key{};
+
+  [[nodiscard]] static auto from(key_tracker* tracker, std::string_view wire)
+    -> std::unique_ptr<key_sample> {
+    return std::make_unique<key_sample>(key_sample{
+      .tracker = tracker,
+      .command = std::string{first_command_verb(wire)},
+      .key = std::string{first_command_key(wire)},
+    });
+  }
+};
+
 /// Abstract interface for delivering responses.
 ///
 /// Used by the pipeline to deliver results without knowing about coroutines.
@@ -75,17 +101,80 @@ class response_sink {
   /// Check if delivery is complete (for diagnostics).
   [[nodiscard]] virtual bool is_complete() const noexcept = 0;
 
+  /// Backpressure: true while the consumer lags behind and the connection should stop reading
+  /// further replies (see `response_stream`). Called from the connection strand.
+  [[nodiscard]] virtual bool saturated() const noexcept { return false; }
+
+  /// `accepted` is when the connection strand admitted the request (phase tracing only).
   auto set_trace_context(request_trace_hooks hooks, request_trace_info info,
-                         std::chrono::steady_clock::time_point start) noexcept -> void {
+                         std::chrono::steady_clock::time_point start,
+                         std::chrono::steady_clock::time_point accepted = {}) noexcept -> void {
     trace_hooks_ = hooks;
     trace_info_ = info;
     trace_start_ = start;
     trace_enabled_ = hooks.enabled();
     trace_finished_ = false;
+    phases_ = request_trace_phases{.info = info, .enqueued = start, .accepted = accepted};
+  }
+
+  /// Phase tracing: every wire byte of the request was handed to the socket (the latest write
+  /// wins when a replayed request is written again).
+  virtual auto stamp_written(std::chrono::steady_clock::time_point t) noexcept -> void {
+    phases_.written = t;
+  }
+
+  /// Phase tracing: a reply for this request was read at `read_at` and parsed at `parsed_at`
+  /// (only the first reply is kept).
+  virtual auto stamp_reply(std::chrono::steady_clock::time_point read_at,
+                           std::chrono::steady_clock::time_point parsed_at) noexcept -> void {
+    if (phases_.parsed == std::chrono::steady_clock::time_point{}) {
+      phases_.reply_read = read_at;
+      phases_.parsed = parsed_at;
+    }
   }
 
   [[nodiscard]] auto has_trace_context() const noexcept -> bool { return trace_enabled_; }
 
+  /// Record the request latency into `target` on completion (see `config::latency`).
+  /// The histograms must outlive the sink's completion.
+  auto set_latency_target(latency_recorder::target target,
+                          std::chrono::steady_clock::time_point start) noexcept -> void {
+    latency_target_ = target;
+    trace_start_ = start;
+  }
+
+  /// Record the request latency into `window` when it completes without error (see
+  /// `config::adaptive_timeout`). The histogram must outlive the sink's completion.
+  auto set_timeout_window(latency_histogram* window,
+                          std::chrono::steady_clock::time_point start) noexcept -> void {
+    timeout_window_ = window;
+    trace_start_ = start;
+  }
+
+  /// Report the request to `sample->tracker` on completion (see `config::key_tracking`).
+  auto set_key_sample(std::unique_ptr<key_sample> sample) noexcept -> void {
+    key_sample_ = std::move(sample);
+  }
+
+  /// Copy the request into `log` on completion when it took at least `threshold` (see
+  /// `config::slow_requests`). `info` describes the request when tracing did not already.
+  /// The log must outlive the sink's completion.
+  auto set_slow_request_log(slow_request_log* log, std::chrono::nanoseconds threshold,
+                            std::uint64_t generation, request_trace_info const& info,
+                            std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point accepted) noexcept -> void {
+    slow_log_ = log;
+    slow_threshold_ = threshold;
+    generation_ = generation;
+    trace_start_ = start;
+    if (!trace_enabled_) {
+      phases_ = request_trace_phases{.info = info, .enqueued = start, .accepted = accepted};
+    }
+  }
+
+  /// `n` wire bytes of a reply for this request were parsed (key tracking, slow-request log).
+  virtual auto add_reply_bytes(std::size_t n) noexcept -> void { reply_bytes_ += n; }
+
  protected:
   struct trace_summary {
     std::size_t ok_count{0};
@@ -120,9 +209,43 @@ class response_sink {
   }
 
   auto emit_trace_finish(trace_summary const& summary) noexcept -> void {
+    auto const now =
+      (has_trace_context() || latency_target_.overall != nullptr || slow_log_ != nullptr ||
+       timeout_window_ != nullptr)
+        ? std::chrono::steady_clock::now()
+        : std::chrono::steady_clock::time_point{};
+    if (latency_target_.overall != nullptr) {
+      auto const d = std::chrono::duration_cast<std::chrono::nanoseconds>(now - trace_start_);
+      latency_target_.overall->record(d);
+      if (latency_target_.command != nullptr) {
+        latency_target_.command->record(d);
+      }
+      latency_target_ = {};
+    }
+    if (timeout_window_ != nullptr) {
+      // Failures (timeouts above all) would only drag the budget after the failure itself.
+      if (!summary.primary_error) {
+        timeout_window_->record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - trace_start_));
+      }
+      timeout_window_ = nullptr;
+    }
+    if (key_sample_ != nullptr) {
+      auto const sample = std::move(key_sample_);
+      try {
+        sample->tracker->record(sample->command, sample->key, reply_bytes_);
+      } catch (...) {
+        REDISCORO_LOG_WARNING("key tracking failed: command={}", sample->command);
+      }
+    }
+    if (slow_log_ != nullptr) {
+      record_if_slow(now, summary.primary_error);
+    }
+
     if (!has_trace_context()) {
       return;
     }
+    phases_.adapted = now;
     auto const& hooks = trace_hooks();
     if (hooks.on_finish == nullptr) {
       return;
@@ -133,8 +256,7 @@ class response_sink {
 
     request_trace_finish evt{
       .info = trace_info(),
-      .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::steady_clock::now() - trace_start()),
+      .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - trace_start()),
       .ok_count = summary.ok_count,
       .error_count = summary.error_count,
       .primary_error = summary.primary_error,
@@ -150,12 +272,66 @@ class response_sink {
     }
   }
 
+  /// Report the phase timestamps once the awaiting coroutine resumed at `resumed` (left unset
+  /// for sinks without a waiter). No-op unless `on_phases` is set.
+  auto emit_trace_phases(std::chrono::steady_clock::time_point resumed) noexcept -> void {
+    if (!trace_enabled_ || trace_hooks_.on_phases == nullptr) {
+      return;
+    }
+    phases_.resumed = resumed;
+    try {
+      trace_hooks_.on_phases(trace_hooks_.user_data, phases_);
+    } catch (...) {
+      REDISCORO_LOG_WARNING("trace on_phases callback threw: request_id={} kind={}",
+                            trace_info_.id, to_string(trace_info_.kind));
+    }
+  }
+
+  [[nodiscard]] auto wants_phases() const noexcept -> bool {
+    return trace_enabled_ && trace_hooks_.on_phases != nullptr;
+  }
+
  private:
+  auto record_if_slow(std::chrono::steady_clock::time_point now, std::error_code error) noexcept
+    -> void {
+    auto* const log = std::exchange(slow_log_, nullptr);
+    auto const d = std::chrono::duration_cast<std::chrono::nanoseconds>(now - trace_start_);
+    if (d < slow_threshold_) {
+      return;
+    }
+    try {
+      log->record(slow_request_record{
+        .command = phases_.info.command,
+        .command_count = phases_.info.command_count,
+        .request_bytes = phases_.info.wire_bytes,
+        .reply_bytes = reply_bytes_,
+        .duration = d,
+        .enqueued = phases_.enqueued,
+        .accepted = phases_.accepted,
+        .written = phases_.written,
+        .reply_read = phases_.reply_read,
+        .completed = now,
+        .generation = generation_,
+        .error = error,
+      });
+    } catch (...) {
+      REDISCORO_LOG_WARNING("slow request log failed: command={}", phases_.info.command.view());
+    }
+  }
+
   request_trace_hooks trace_hooks_{};
   request_trace_info trace_info_{};
   std::chrono::steady_clock::time_point trace_start_{};
   bool trace_enabled_{false};
   bool trace_finished_{false};
+  request_trace_phases phases_{};
+  latency_recorder::target latency_target_{};
+  latency_histogram* timeout_window_{nullptr};
+  std::unique_ptr<key_sample> key_sample_{};
+  std::size_t reply_bytes_{0};
+  slow_request_log* slow_log_{nullptr};
+  std::chrono::nanoseconds slow_threshold_{};
+  std::uint64_t generation_{0};
 };
 
 }  // namespace rediscoro::detail
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <iocoro/any_executor.hpp>
+#include <iocoro/awaitable.hpp>
+#include <iocoro/condition_event.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rediscoro::detail {
+
+/// Waiters to resume inline at the end of a read batch (see `config::inline_resume`).
+///
+/// While a batch is open (`batch` guard in `do_read()`), completed waiters are collected and
+/// resumed directly on the connection strand once the batch closes, instead of each being
+/// rescheduled through the executor queue. Completions outside a batch (timeouts, shutdown)
+/// are posted to the strand as before.
+///
+/// Thread-safety: connection strand only.
+class resume_queue {
+ public:
+  explicit resume_queue(iocoro::any_executor strand) : strand_(std::move(strand)) {}
+
+  resume_queue(resume_queue const&) = delete;
+  auto operator=(resume_queue const&) -> resume_queue& = delete;
+
+  /// Keeps a batch open for its lifetime; the outermost guard resumes the collected waiters.
+  class batch {
+   public:
+    explicit batch(resume_queue& q) noexcept : q_(q) { q_.depth_ += 1; }
+    batch(batch const&) = delete;
+    auto operator=(batch const&) -> batch& = delete;
+    ~batch() {
+      if (--q_.depth_ == 0) {
+        q_.drain();
+      }
+    }
+
+   private:
+    resume_queue& q_;
+  };
+
+  auto schedule(std::coroutine_handle<> h) -> void {
+    if (depth_ > 0) {
+      ready_.push_back(h);
+      return;
+    }
+    strand_.post([h]() { h.resume(); });
+  }
+
+ private:
+  auto drain() noexcept -> void {
+    // Resumed coroutines may complete further waiters: they join this drain.
+    depth_ += 1;
+    for (std::size_t i = 0; i < ready_.size(); ++i) {
+      ready_[i].resume();
+    }
+    ready_.clear();
+    depth_ -= 1;
+  }
+
+  iocoro::any_executor strand_;
+  std::size_t depth_{0};
+  std::vector<std::coroutine_handle<>> ready_{};
+};
+
+/// Completion signal of a pending response: a `condition_event`, or an inline waiter resumed
+/// through a `resume_queue` when the connection opted into inline resumption.
+class completion_signal {
+ public:
+  /// Opt into inline resumption. Must be called before `wait()` (i.e. at creation).
+  auto use_inline(resume_queue* q) noexcept -> void { queue_ = q; }
+
+  /// Mark complete (connection strand).
+  auto notify() -> void {
+    if (queue_ == nullptr) {
+      event_.notify();
+      return;
+    }
+    done_ = true;
+    if (waiter_) {
+      queue_->schedule(std::exchange(waiter_, {}));
+    }
+  }
+
+  /// Lifetime: in inline mode the waiting coroutine is resumed through its raw handle. If its
+  /// frame is destroyed while suspended here, the awaiter unregisters it; a frame must not be
+  /// destroyed after `notify()` queued it and before the batch drains.
+  auto wait() -> iocoro::awaitable<void> {
+    if (queue_ == nullptr) {
+      (void)co_await event_.async_wait();
+      co_return;
+    }
+    co_await inline_awaiter{this};
+  }
+
+ private:
+  struct inline_awaiter {
+    completion_signal* self;
+    std::coroutine_handle<> suspended{};
+
+    // Runs on resumption and on destruction of a suspended frame alike: a handle still
+    // registered here must not be resumed later.
+    ~inline_awaiter() {
+      if (suspended && self->waiter_ == suspended) {
+        self->waiter_ = {};
+      }
+    }
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return self->done_; }
+    auto await_suspend(std::coroutine_handle<> h) noexcept -> void {
+      suspended = h;
+      self->waiter_ = h;
+    }
+    auto await_resume() const noexcept -> void {}
+  };
+
+  iocoro::condition_event event_{};
+  resume_queue* queue_{nullptr};
+  bool done_{false};
+  std::coroutine_handle<> waiter_{};
+};
+
+}  // namespace rediscoro::detail
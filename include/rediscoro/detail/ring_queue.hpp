@@ -109,6 +109,19 @@ class ring_queue {
     size_ += 1;
   }
 
+  /// Indexed access from the front (0 == front()).
+  [[nodiscard]] auto at(std::size_t i) -> T& {
+    REDISCORO_ASSERT(i < size_);
+    const auto idx = (head_ + i) % cap_;
+    return data_[idx];
+  }
+
+  [[nodiscard]] auto at(std::size_t i) const -> const T& {
+    REDISCORO_ASSERT(i < size_);
+    const auto idx = (head_ + i) % cap_;
+    return data_[idx];
+  }
+
   auto push_back(const T& v) -> void { emplace_back(v); }
   auto push_back(T&& v) -> void { emplace_back(std::move(v)); }
 
@@ -126,12 +139,6 @@ class ring_queue {
   std::size_t head_{0};
   std::size_t size_{0};
 
-  [[nodiscard]] auto at(std::size_t i) -> T& {
-    REDISCORO_ASSERT(i < size_);
-    const auto idx = (head_ + i) % cap_;
-    return data_[idx];
-  }
-
   auto ensure_capacity(std::size_t need) -> void {
     if (cap_ >= need) {
       return;
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <rediscoro/assert.hpp>
+#include <rediscoro/detail/response_sink.hpp>
+#include <rediscoro/error_info.hpp>
+#include <rediscoro/resp3/message.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rediscoro::detail {
+
+class singleflight_group;
+
+/// Sink that stands in the pipeline for one in-flight request and fans every reply (or error)
+/// out to the leader and all followers that joined while it was in flight.
+///
+/// Followers receive copies; the leader (first sink) receives the original message. Messages
+/// view the parser buffer, so every target consumes its copy synchronously inside deliver().
+class singleflight_sink final : public response_sink {
+ public:
+  singleflight_sink(singleflight_group* group, std::string key,
+                    std::shared_ptr<response_sink> leader)
+      : group_(group), key_(std::move(key)), expected_(leader->expected_replies()) {
+    targets_.push_back(std::move(leader));
+  }
+
+  [[nodiscard]] std::size_t expected_replies() const noexcept override { return expected_; }
+
+  [[nodiscard]] bool is_complete() const noexcept override { return delivered_ == expected_; }
+
+  /// A follower may only join before the first reply arrives; otherwise it would miss replies.
+  [[nodiscard]] auto can_join() const noexcept -> bool { return delivered_ == 0; }
+
+  auto add_follower(std::shared_ptr<response_sink> sink) -> void {
+    REDISCORO_ASSERT(can_join());
+    REDISCORO_ASSERT(sink->expected_replies() == expected_);
+    targets_.push_back(std::move(sink));
+  }
+
+  [[nodiscard]] auto key() const noexcept -> std::string const& { return key_; }
+  [[nodiscard]] auto follower_count() const noexcept -> std::size_t { return targets_.size() - 1; }
+
+  /// Detach from the group without delivering (used when the pipeline refused the request).
+  auto detach() noexcept -> void { group_ = nullptr; }
+
+  // Phase stamps and reply sizes apply to every request sharing this round trip.
+  auto stamp_written(std::chrono::steady_clock::time_point t) noexcept -> void override {
+    for (auto const& target : targets_) {
+      target->stamp_written(t);
+    }
+  }
+
+  auto stamp_reply(std::chrono::steady_clock::time_point read_at,
+                   std::chrono::steady_clock::time_point parsed_at) noexcept -> void override {
+    for (auto const& target : targets_) {
+      target->stamp_reply(read_at, parsed_at);
+    }
+  }
+
+  auto add_reply_bytes(std::size_t n) noexcept -> void override {
+    for (auto const& target : targets_) {
+      target->add_reply_bytes(n);
+    }
+  }
+
+  /// Backpressure of any sharer holds the shared round trip: every target buffers each reply,
+  /// so the slowest consumer paces the read (e.g. deduplicated `exec_stream` reads).
+  [[nodiscard]] bool saturated() const noexcept override {
+    for (auto const& target : targets_) {
+      if (target->saturated()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ protected:
+  void do_deliver(resp3::message msg) override {
+    for (std::size_t i = 1; i < targets_.size(); ++i) {
+      targets_[i]->deliver(msg);
+    }
+    targets_.front()->deliver(std::move(msg));
+    on_delivered();
+  }
+
+  void do_deliver_error(error_info err) override {
+    for (std::size_t i = 1; i < targets_.size(); ++i) {
+      targets_[i]->deliver_error(err);
+    }
+    targets_.front()->deliver_error(std::move(err));
+    on_delivered();
+  }
+
+ private:
+  inline void on_delivered();
+
+  singleflight_group* group_;
+  std::string key_;
+  std::size_t expected_;
+  std::size_t delivered_{0};
+  std::vector<std::shared_ptr<response_sink>> targets_{};
+};
+
+/// Tracks in-flight read-only requests by their encoded wire bytes ("singleflight").
+///
+/// Concurrent identical requests share one server round trip: the first becomes the leader and
+/// is pushed to the pipeline through a `singleflight_sink`; later identical requests attach to it
+/// as followers and are never written.
+///
+/// Memory is bounded by `limits`: requests larger than `max_key_bytes`, or arriving while
+/// `max_inflight_keys` entries are tracked, simply bypass deduplication.
+///
+/// Thread-safety: connection strand only.
+class singleflight_group {
+ public:
+  struct limits {
+    std::size_t max_inflight_keys = 1024U;
+    std::size_t max_key_bytes = 1024U;
+  };
+
+  singleflight_group() = default;
+  explicit singleflight_group(limits lim) : limits_(lim) {}
+
+  singleflight_group(singleflight_group const&) = delete;
+  auto operator=(singleflight_group const&) -> singleflight_group& = delete;
+
+  /// Attach `sink` to an in-flight identical request. Returns false if there is none to join.
+  [[nodiscard]] auto try_join(std::string_view wire, std::shared_ptr<response_sink> const& sink)
+    -> bool {
+    auto it = inflight_.find(wire);
+    if (it == inflight_.end() || !it->second->can_join()) {
+      return false;
+    }
+    it->second->add_follower(sink);
+    return true;
+  }
+
+  /// Start tracking `wire` with `leader` as the first consumer.
+  ///
+  /// Returns the fan-out sink to push into the pipeline instead of `leader`, or nullptr when the
+  /// request is not eligible under the memory bounds (push `leader` directly in that case).
+  [[nodiscard]] auto lead(std::string_view wire, std::shared_ptr<response_sink> leader)
+    -> std::shared_ptr<singleflight_sink> {
+    if (wire.size() > limits_.max_key_bytes || inflight_.size() >= limits_.max_inflight_keys) {
+      return nullptr;
+    }
+    auto flight = std::make_shared<singleflight_sink>(this, std::string{wire}, std::move(leader));
+    // Replace (not assign): the map key must view the new flight's bytes.
+    inflight_.erase(std::string_view{flight->key()});
+    inflight_.emplace(std::string_view{flight->key()}, flight);
+    return flight;
+  }
+
+  /// Stop tracking a flight that never made it into the pipeline.
+  auto abandon(std::shared_ptr<singleflight_sink> const& flight) -> void {
+    erase(*flight);
+    flight->detach();
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return inflight_.size(); }
+
+ private:
+  friend class singleflight_sink;
+
+  auto erase(singleflight_sink const& flight) -> void {
+    auto it = inflight_.find(flight.key());
+    if (it != inflight_.end() && it->second.get() == &flight) {
+      inflight_.erase(it);
+    }
+  }
+
+  limits limits_{};
+  // Keys view the flight's own copy of the wire bytes, which lives as long as the entry.
+  std::unordered_map<std::string_view, std::shared_ptr<singleflight_sink>> inflight_{};
+};
+
+inline void singleflight_sink::on_delivered() {
+  delivered_ += 1;
+  if (delivered_ == 1 && group_ != nullptr) {
+    // No more followers may join once replies start arriving: stop tracking right away.
+    group_->erase(*this);
+    group_ = nullptr;
+  }
+}
+
+}  // namespace rediscoro::detail
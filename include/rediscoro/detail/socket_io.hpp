@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/types.h>
+#define REDISCORO_HAS_NONBLOCKING_RECV 1
+#else
+#define REDISCORO_HAS_NONBLOCKING_RECV 0
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace rediscoro::detail {
+
+/// Outcome of one non-blocking read attempt.
+enum class nonblocking_read_status {
+  data,         // `bytes` bytes were read
+  would_block,  // nothing to read right now (or unsupported on this platform)
+  eof,          // peer closed
+  error,        // socket error (`error` holds it)
+};
+
+struct nonblocking_read_result {
+  nonblocking_read_status status = nonblocking_read_status::would_block;
+  std::size_t bytes = 0;
+  std::error_code error{};
+};
+
+/// Read whatever is already queued on `fd` without blocking and without touching the reactor.
+///
+/// Must only be called while no asynchronous read is outstanding on the socket. On platforms
+/// without `MSG_DONTWAIT` this always reports would_block, so callers fall back to their
+/// regular asynchronous read.
+[[nodiscard]] inline auto try_read_nonblocking(int fd, std::span<std::byte> buf) noexcept
+  -> nonblocking_read_result {
+#if REDISCORO_HAS_NONBLOCKING_RECV
+  if (fd < 0 || buf.empty()) {
+    return {};
+  }
+  for (;;) {
+    auto const n = ::recv(fd, buf.data(), buf.size(), MSG_DONTWAIT);
+    if (n > 0) {
+      return {.status = nonblocking_read_status::data, .bytes = static_cast<std::size_t>(n)};
+    }
+    if (n == 0) {
+      return {.status = nonblocking_read_status::eof};
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return {};
+    }
+    return {.status = nonblocking_read_status::error,
+            .error = std::error_code{errno, std::generic_category()}};
+  }
+#else
+  (void)fd;
+  (void)buf;
+  return {};
+#endif
+}
+
+/// Spin-wait hint for busy loops (PAUSE on x86; no-op elsewhere).
+inline auto cpu_relax() noexcept -> void {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/// Enable kernel busy polling on `fd` (Linux SO_BUSY_POLL / SO_PREFER_BUSY_POLL).
+///
+/// Returns operation_not_supported where the options do not exist. The kernel may also refuse
+/// values above `net.core.busy_read` without CAP_NET_ADMIN.
+[[nodiscard]] inline auto set_busy_poll(int fd, std::chrono::microseconds timeout,
+                                        bool prefer) noexcept -> std::error_code {
+#if defined(SO_BUSY_POLL)
+  int usec = static_cast<int>(timeout.count());
+  if (::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) != 0) {
+    return std::error_code{errno, std::generic_category()};
+  }
+  if (prefer) {
+#if defined(SO_PREFER_BUSY_POLL)
+    int on = 1;
+    if (::setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &on, sizeof(on)) != 0) {
+      return std::error_code{errno, std::generic_category()};
+    }
+#else
+    return std::make_error_code(std::errc::operation_not_supported);
+#endif
+  }
+  return {};
+#else
+  (void)fd;
+  (void)timeout;
+  (void)prefer;
+  return std::make_error_code(std::errc::operation_not_supported);
+#endif
+}
+
+}  // namespace rediscoro::detail
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <rediscoro/assert.hpp>
+#include <rediscoro/detail/response_builder.hpp>
+#include <rediscoro/detail/response_sink.hpp>
+#include <rediscoro/error_info.hpp>
+#include <rediscoro/response.hpp>
+
+#include <iocoro/awaitable.hpp>
+#include <iocoro/condition_event.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace rediscoro::detail {
+
+/// Sink that hands replies to a consumer one by one instead of collecting all of them
+/// (`response_stream`).
+///
+/// Each reply is adapted to `response_slot<T>` on delivery and buffered until the consumer
+/// takes it with `next()`. Once `max_buffered` slots are waiting, `saturated()` asks the
+/// connection to stop reading (backpressure reaches the server through TCP); the consumer wakes
+/// the reader again after draining the buffer to half of that.
+///
+/// Thread-safety:
+/// - deliver()/deliver_error()/saturated() run on the connection strand.
+/// - next()/abandon() may run on any executor (buffer guarded by a mutex).
+template <typename T>
+class stream_sink final : public response_sink {
+ public:
+  stream_sink(std::size_t expected_count, std::size_t max_buffered)
+      : expected_(expected_count), max_buffered_(max_buffered == 0 ? 1 : max_buffered) {}
+
+  [[nodiscard]] std::size_t expected_replies() const noexcept override { return expected_; }
+
+  [[nodiscard]] bool is_complete() const noexcept override { return delivered_ == expected_; }
+
+  [[nodiscard]] bool saturated() const noexcept override {
+    std::lock_guard lock(mu_);
+    return !abandoned_ && buffered_.size() >= max_buffered_;
+  }
+
+  /// Called (from the consumer's thread) when a paused reader may continue.
+  /// Must be set before the request is enqueued.
+  auto set_resume_reader(std::function<void()> fn) -> void { resume_reader_ = std::move(fn); }
+
+  /// Next reply in order, or nullopt once every reply was consumed.
+  auto next() -> iocoro::awaitable<std::optional<response_slot<T>>> {
+    for (;;) {
+      bool resume = false;
+      std::optional<response_slot<T>> out{};
+      {
+        std::lock_guard lock(mu_);
+        if (!buffered_.empty()) {
+          out.emplace(std::move(buffered_.front()));
+          buffered_.pop_front();
+          consumed_ += 1;
+          resume = buffered_.size() == max_buffered_ / 2;
+        } else if (consumed_ == expected_) {
+          co_return std::nullopt;
+        }
+      }
+      if (out.has_value()) {
+        if (resume && resume_reader_) {
+          resume_reader_();
+        }
+        co_return out;
+      }
+      (void)co_await ready_.async_wait();
+    }
+  }
+
+  /// The consumer went away: drop buffered and future replies, never pause the reader again.
+  auto abandon() -> void {
+    bool was_saturated = false;
+    {
+      std::lock_guard lock(mu_);
+      was_saturated = buffered_.size() >= max_buffered_;
+      abandoned_ = true;
+      buffered_.clear();
+    }
+    if (was_saturated && resume_reader_) {
+      resume_reader_();
+    }
+  }
+
+ protected:
+  void do_deliver(resp3::message msg) override {
+    push(slot_from_message<T>(std::move(msg)));
+  }
+
+  void do_deliver_error(error_info err) override {
+    if (!first_error_.has_value()) {
+      first_error_ = err;
+    }
+    push(slot_from_error<T>(std::move(err)));
+  }
+
+ private:
+  auto push(response_slot<T> slot) -> void {
+    REDISCORO_ASSERT(delivered_ < expected_);
+    delivered_ += 1;
+    if (slot) {
+      ok_count_ += 1;
+    } else {
+      error_count_ += 1;
+    }
+    {
+      std::lock_guard lock(mu_);
+      if (!abandoned_) {
+        buffered_.push_back(std::move(slot));
+      }
+    }
+    ready_.notify();
+
+    if (is_complete()) {
+      emit_trace_finish(trace_summary{
+        .ok_count = ok_count_,
+        .error_count = error_count_,
+        .primary_error = first_error_.has_value() ? first_error_->code : std::error_code{},
+        .primary_error_detail =
+          first_error_.has_value() ? std::string_view{first_error_->detail} : std::string_view{},
+      });
+      emit_trace_phases({});
+    }
+  }
+
+  // Strand-only.
+  std::size_t expected_;
+  std::size_t delivered_{0};
+  std::size_t ok_count_{0};
+  std::size_t error_count_{0};
+  std::optional<error_info> first_error_{};
+
+  std::size_t const max_buffered_;
+  std::function<void()> resume_reader_{};
+  iocoro::condition_event ready_{};
+
+  // Shared with the consumer.
+  mutable std::mutex mu_{};
+  std::deque<response_slot<T>> buffered_{};
+  std::size_t consumed_{0};
+  bool abandoned_{false};
+};
+
+}  // namespace rediscoro::detail
@@ -62,6 +62,13 @@ enum class client_errc {
 
   /// Internal error (bug / invariant violation).
   internal_error,
+
+  /// Health-check PING went unanswered (half-open connection; see `health_check_options`).
+  health_check_failed,
+
+  /// Request was written but its connection failed before the reply: it may have executed on
+  /// the server, so it is never replayed (see `config::pipelined_handshake`).
+  outcome_unknown,
 };
 
 enum class protocol_errc {
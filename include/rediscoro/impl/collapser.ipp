@@ -0,0 +1,169 @@
+#pragma once
+
+#include <rediscoro/collapser.hpp>
+#include <rediscoro/error.hpp>
+#include <rediscoro/logger.hpp>
+#include <rediscoro/request.hpp>
+
+#include <iocoro/co_spawn.hpp>
+#include <iocoro/steady_timer.hpp>
+#include <iocoro/strand.hpp>
+
+#include <span>
+#include <string_view>
+
+namespace rediscoro {
+
+inline collapser::collapser(iocoro::any_io_executor ex, client& c, collapser_options opts)
+    : state_(std::make_shared<detail::collapser_state>(ex, c, opts)) {}
+
+inline auto collapser::get(std::string key) -> iocoro::awaitable<response_slot<value_type>> {
+  auto waiter = std::make_shared<detail::collapse_waiter>();
+  state_->strand().dispatch([state = state_, key = std::move(key), waiter]() mutable {
+    state->join(false, std::string{}, std::move(key), std::move(waiter));
+  });
+  (void)co_await waiter->ready.async_wait();
+  co_return std::move(*waiter->result);
+}
+
+inline auto collapser::hget(std::string key, std::string field)
+  -> iocoro::awaitable<response_slot<value_type>> {
+  auto waiter = std::make_shared<detail::collapse_waiter>();
+  state_->strand().dispatch(
+    [state = state_, key = std::move(key), field = std::move(field), waiter]() mutable {
+      state->join(true, std::move(key), std::move(field), std::move(waiter));
+    });
+  (void)co_await waiter->ready.async_wait();
+  co_return std::move(*waiter->result);
+}
+
+}  // namespace rediscoro
+
+namespace rediscoro::detail {
+
+inline collapser_state::collapser_state(iocoro::any_io_executor ex, client& c,
+                                        collapser_options opts)
+    : io_executor_(ex),
+      strand_(iocoro::make_strand(iocoro::any_executor{ex})),
+      client_(&c),
+      opts_(opts) {
+  if (opts_.max_keys == 0) {
+    opts_.max_keys = 1;
+  }
+}
+
+inline void collapser_state::join(bool is_hash, std::string hash_key, std::string arg,
+                                  std::shared_ptr<collapse_waiter> waiter) {
+  auto& slot = open_batch(is_hash, hash_key);
+  if (!slot) {
+    slot = std::make_shared<collapse_batch>();
+    slot->is_hash = is_hash;
+    slot->hash_key = std::move(hash_key);
+    schedule_flush(slot);
+  }
+
+  // Copy the handle: seal() below may erase the map entry that `slot` refers to.
+  auto batch = slot;
+  auto [it, inserted] = batch->index.try_emplace(std::move(arg), batch->args.size());
+  if (inserted) {
+    batch->args.push_back(it->first);
+  }
+  batch->waiters.emplace_back(it->second, std::move(waiter));
+
+  if (batch->args.size() >= opts_.max_keys) {
+    seal(batch);
+    iocoro::co_spawn(strand_, flush(shared_from_this(), batch), iocoro::detached);
+  }
+}
+
+inline auto collapser_state::open_batch(bool is_hash, const std::string& hash_key)
+  -> std::shared_ptr<collapse_batch>& {
+  if (!is_hash) {
+    return open_mget_;
+  }
+  return open_hmget_[hash_key];
+}
+
+inline void collapser_state::seal(const std::shared_ptr<collapse_batch>& batch) {
+  if (!batch->is_hash) {
+    if (open_mget_ == batch) {
+      open_mget_.reset();
+    }
+    return;
+  }
+  auto it = open_hmget_.find(batch->hash_key);
+  if (it != open_hmget_.end() && it->second == batch) {
+    open_hmget_.erase(it);
+  }
+}
+
+inline void collapser_state::schedule_flush(const std::shared_ptr<collapse_batch>& batch) {
+  if (opts_.window.count() > 0) {
+    iocoro::co_spawn(strand_, flush_after_window(shared_from_this(), batch), iocoro::detached);
+    return;
+  }
+
+  // Zero window: post (never dispatch) so reads issued in the current turn can still join.
+  strand_.post([self = shared_from_this(), batch]() mutable {
+    auto ex = self->strand_;
+    iocoro::co_spawn(ex, flush(std::move(self), std::move(batch)), iocoro::detached);
+  });
+}
+
+inline auto collapser_state::flush_after_window(std::shared_ptr<collapser_state> self,
+                                                std::shared_ptr<collapse_batch> batch)
+  -> iocoro::awaitable<void> {
+  iocoro::steady_timer timer{self->io_executor_};
+  timer.expires_after(self->opts_.window);
+  (void)co_await timer.async_wait(iocoro::use_awaitable);
+  co_await flush(std::move(self), std::move(batch));
+}
+
+inline auto collapser_state::flush(std::shared_ptr<collapser_state> self,
+                                   std::shared_ptr<collapse_batch> batch)
+  -> iocoro::awaitable<void> {
+  if (batch->flushed) {
+    co_return;
+  }
+  batch->flushed = true;
+  self->seal(batch);
+
+  std::vector<std::string_view> argv{};
+  argv.reserve(batch->args.size() + 2);
+  argv.emplace_back(batch->is_hash ? "HMGET" : "MGET");
+  if (batch->is_hash) {
+    argv.emplace_back(batch->hash_key);
+  }
+  for (const auto& arg : batch->args) {
+    argv.emplace_back(arg);
+  }
+  request req{std::span<const std::string_view>{argv}};
+
+  REDISCORO_LOG_DEBUG("collapser flush: command={} keys={} waiters={}", argv.front(),
+                      batch->args.size(), batch->waiters.size());
+
+  auto resp = co_await self->client_->exec<std::vector<value_type>>(std::move(req));
+  complete(*batch, resp.get<0>());
+}
+
+inline void collapser_state::complete(collapse_batch& batch,
+                                      const response_slot<std::vector<value_type>>& reply) {
+  std::optional<error_info> err{};
+  if (!reply) {
+    err = reply.error();
+  } else if (reply->size() != batch.args.size()) {
+    err = error_info{client_errc::internal_error, "collapsed reply size mismatch"};
+  }
+
+  for (auto& [idx, waiter] : batch.waiters) {
+    if (err) {
+      waiter->result = unexpected(*err);
+    } else {
+      waiter->result = (*reply)[idx];
+    }
+    waiter->ready.notify();
+  }
+  batch.waiters.clear();
+}
+
+}  // namespace rediscoro::detail
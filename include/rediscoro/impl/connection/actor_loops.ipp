@@ -9,6 +9,12 @@
 #include <iocoro/when_all.hpp>
 #include <iocoro/when_any.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
 namespace rediscoro::detail {
 
 // -------------------- Actor loops --------------------
@@ -26,8 +32,11 @@ inline auto connection::actor_loop() -> iocoro::awaitable<void> {
                                  iocoro::use_awaitable);
   auto controller = iocoro::co_spawn(ex, parent_stop, iocoro::bind_executor(ex, control_loop()),
                                      iocoro::use_awaitable);
+  auto standby = iocoro::co_spawn(ex, parent_stop, iocoro::bind_executor(ex, standby_loop()),
+                                  iocoro::use_awaitable);
 
-  (void)co_await iocoro::when_all(std::move(writer), std::move(reader), std::move(controller));
+  (void)co_await iocoro::when_all(std::move(writer), std::move(reader), std::move(controller),
+                                  std::move(standby));
 
   REDISCORO_LOG_DEBUG("actor loop end");
   transition_to_closed();
@@ -54,7 +63,8 @@ inline auto connection::read_loop() -> iocoro::awaitable<void> {
   auto tok = co_await iocoro::this_coro::stop_token;
   REDISCORO_LOG_DEBUG("read loop start");
   while (!tok.stop_requested() && state_ != connection_state::CLOSED) {
-    if (state_ != connection_state::OPEN) {
+    if (state_ != connection_state::OPEN || pipeline_.read_paused()) {
+      // Paused: a response_stream consumer is behind; it wakes us after draining.
       (void)co_await read_wakeup_.async_wait();
       continue;
     }
@@ -89,26 +99,35 @@ inline auto connection::control_loop() -> iocoro::awaitable<void> {
       continue;
     }
 
-    if (state_ == connection_state::OPEN && cfg_.request_timeout.has_value()) {
+    auto next = pipeline::time_point::max();
+    if (state_ == connection_state::OPEN && enforces_deadlines()) {
       if (pipeline_.has_expired()) {
         REDISCORO_LOG_DEBUG("request timeout deadline reached");
+        metrics_.timeouts.add();
         handle_error(client_errc::request_timeout);
         continue;
       }
+      next = pipeline_.next_deadline();
+    }
 
-      const auto next = pipeline_.next_deadline();
-      if (next != pipeline::time_point::max()) {
-        iocoro::steady_timer timer{executor_.get_io_executor()};
-        timer.expires_at(next);
-
-        auto timer_wait = timer.async_wait(iocoro::use_awaitable);
-        auto wake_wait = control_wakeup_.async_wait();
-        (void)co_await iocoro::when_any(std::move(timer_wait), std::move(wake_wait));
-        REDISCORO_LOG_DEBUG("request timeout wait woke up (timer or control signal)");
+    if (state_ == connection_state::OPEN && cfg_.health_check.enabled) {
+      next = std::min(next, health_tick());
+      if (state_ != connection_state::OPEN) {
         continue;
       }
     }
 
+    if (next != pipeline::time_point::max()) {
+      iocoro::steady_timer timer{executor_.get_io_executor()};
+      timer.expires_at(next);
+
+      auto timer_wait = timer.async_wait(iocoro::use_awaitable);
+      auto wake_wait = control_wakeup_.async_wait();
+      (void)co_await iocoro::when_any(std::move(timer_wait), std::move(wake_wait));
+      REDISCORO_LOG_DEBUG("control deadline wait woke up (timer or control signal)");
+      continue;
+    }
+
     if (state_ == connection_state::CLOSING) {
       // close() or error path requested shutdown; let actor_loop join complete.
       break;
@@ -121,4 +140,108 @@ inline auto connection::control_loop() -> iocoro::awaitable<void> {
   co_return;
 }
 
+inline auto connection::health_tick() -> pipeline::time_point {
+  auto const& hc = cfg_.health_check;
+  auto const now = pipeline::clock::now();
+
+  if (health_probe_ != nullptr) {
+    if (health_probe_->is_complete()) {
+      finish_health_probe();
+    } else if (now < health_probe_->sent_at() + hc.timeout) {
+      return health_probe_->sent_at() + hc.timeout;
+    } else {
+      // Nothing came back, not even for the PING: the peer is gone without FIN/RST.
+      REDISCORO_LOG_WARNING("health check failed: PING unanswered after timeout_ms={}",
+                            hc.timeout.count());
+      metrics_.health_check_failures.add();
+      health_probe_.reset();
+      handle_error(client_errc::health_check_failed);
+      return pipeline::time_point::max();
+    }
+  }
+
+  // Idle means: nothing in flight and no reply parsed since the last step. Replies are counted
+  // anyway, so the read path pays nothing for this.
+  auto const seen = metrics_.messages_parsed.load();
+  if (seen != health_seen_messages_ || pipeline_.pending_count() != 0) {
+    health_seen_messages_ = seen;
+    health_idle_since_ = now;
+  }
+  if (now < health_idle_since_ + hc.interval) {
+    return health_idle_since_ + hc.interval;
+  }
+
+  auto probe = std::make_shared<health_probe_sink>(now);
+  pipeline_.push_internal(request{"PING"}, probe);
+  REDISCORO_LOG_DEBUG("health check: PING sent, interval_ms={}", hc.interval.count());
+  health_probe_ = std::move(probe);
+  metrics_.health_checks.add();
+  update_queue_gauges();
+  write_wakeup_.notify();
+  return now + hc.timeout;
+}
+
+inline auto connection::finish_health_probe() noexcept -> void {
+  auto const probe = std::exchange(health_probe_, nullptr);
+  if (!probe->answered()) {
+    // Failed locally (disconnect); the error path already accounts for it.
+    return;
+  }
+  auto const rtt = probe->rtt();
+  // EWMA with weight 1/8 (as TCP's SRTT); the first sample seeds it.
+  ping_rtt_ewma_ = ping_rtt_ewma_.count() == 0 ? rtt : ping_rtt_ewma_ + (rtt - ping_rtt_ewma_) / 8;
+  auto const us = [](std::chrono::nanoseconds d) {
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+  };
+  metrics_.ping_rtt_us.set(us(rtt));
+  metrics_.ping_rtt_ewma_us.set(us(ping_rtt_ewma_));
+}
+
+inline auto connection::standby_loop() -> iocoro::awaitable<void> {
+  if (!cfg_.standby.enabled || !cfg_.reconnection.enabled) {
+    co_return;
+  }
+
+  auto tok = co_await iocoro::this_coro::stop_token;
+  REDISCORO_LOG_DEBUG("standby loop start");
+  while (!tok.stop_requested() && state_ != connection_state::CLOSING &&
+         state_ != connection_state::CLOSED) {
+    // (Re)open only next to a healthy active connection; while it is down, reconnection or
+    // promotion is already in charge.
+    if (state_ != connection_state::OPEN || standby_ready_) {
+      (void)co_await standby_wakeup_.async_wait();
+      continue;
+    }
+
+    auto r = co_await open_standby();
+    if (tok.stop_requested()) {
+      break;
+    }
+    if (!r) {
+      REDISCORO_LOG_WARNING("standby connect failed: err_code={} err_msg={} detail={} retry_ms={}",
+                            r.error().code.value(), r.error().code.message(), r.error().detail,
+                            cfg_.standby.retry_delay.count());
+      iocoro::steady_timer timer{executor_.get_io_executor()};
+      timer.expires_after(cfg_.standby.retry_delay);
+      auto timer_wait = timer.async_wait(iocoro::use_awaitable);
+      auto wake_wait = standby_wakeup_.async_wait();
+      (void)co_await iocoro::when_any(std::move(timer_wait), std::move(wake_wait));
+      continue;
+    }
+
+    standby_ready_ = true;
+    REDISCORO_LOG_INFO("standby ready: state={}", to_string(state_));
+    // A reconnect backoff may be waiting for exactly this.
+    control_wakeup_.notify();
+  }
+
+  if (standby_socket_.is_open()) {
+    (void)standby_socket_.close();
+  }
+  standby_ready_ = false;
+  REDISCORO_LOG_DEBUG("standby loop stop");
+  co_return;
+}
+
 }  // namespace rediscoro::detail
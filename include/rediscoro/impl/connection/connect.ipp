@@ -4,15 +4,24 @@
 #include <rediscoro/ignore.hpp>
 #include <rediscoro/resp3/builder.hpp>
 
+#include <iocoro/co_spawn.hpp>
+#include <iocoro/condition_event.hpp>
 #include <iocoro/ip/resolver.hpp>
 #include <iocoro/socket_option.hpp>
+#include <iocoro/steady_timer.hpp>
 #include <iocoro/this_coro.hpp>
+#include <iocoro/when_any.hpp>
 #include <iocoro/with_timeout.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <system_error>
+#include <vector>
 
 namespace rediscoro::detail {
 
@@ -28,107 +37,88 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
   // Defensive: ensure parser state is clean at the start of a handshake.
   // This prevents accidental carry-over between retries or reconnect attempts.
   parser_.reset();
+  parse_buffered_ = false;
 
-  // Resolve:
-  // - iocoro resolver runs getaddrinfo on a background thread_pool and resumes on this coroutine's
-  //   executor (our strand).
-  // - Cancellation is best-effort via stop_token. It cannot interrupt an in-flight getaddrinfo()
-  //   but can prevent delivering results to the awaiting coroutine.
-  iocoro::ip::tcp::resolver resolver{};
-  auto resolve_res = resolver.async_resolve(cfg_.host, std::to_string(cfg_.port));
-  if (cfg_.resolve_timeout.has_value()) {
-    resolve_res = iocoro::with_timeout(std::move(resolve_res), *cfg_.resolve_timeout);
+  bool from_cache = false;
+  auto endpoints = co_await resolve_endpoints(from_cache);
+  if (!endpoints) {
+    co_return unexpected(std::move(endpoints.error()));
   }
-  auto res = co_await std::move(resolve_res);
-  if (!res) {
-    REDISCORO_LOG_WARNING("resolve failed: host={} port={} err_code={} err_msg={}", cfg_.host,
-                          cfg_.port, res.error().value(), res.error().message());
-    if (res.error() == iocoro::error::timed_out) {
-      co_return unexpected(client_errc::resolve_timeout);
-    } else if (res.error() == iocoro::error::operation_aborted) {
-      co_return unexpected(client_errc::operation_aborted);
-    } else {
-      co_return unexpected(client_errc::resolve_failed);
+
+  if (tok.stop_requested()) {
+    co_return unexpected(client_errc::operation_aborted);
+  }
+
+  auto connected = co_await connect_endpoints(*endpoints, socket_);
+  if (!connected && from_cache && connected.error().code != client_errc::operation_aborted &&
+      !tok.stop_requested()) {
+    // Cached endpoints may be outdated (e.g. a failover moved the DNS record): resolve again and
+    // retry only if the answer actually changed.
+    REDISCORO_LOG_INFO("cached endpoints unreachable, resolving again: host={} port={}", cfg_.host,
+                       cfg_.port);
+    auto const previous = std::move(*endpoints);
+    endpoint_cache_.invalidate();
+    endpoints = co_await resolve_endpoints(from_cache);
+    if (!endpoints) {
+      co_return unexpected(std::move(endpoints.error()));
+    }
+    if (!std::ranges::is_permutation(*endpoints, previous)) {
+      connected = co_await connect_endpoints(*endpoints, socket_);
     }
   }
-  if (res->empty()) {
-    REDISCORO_LOG_WARNING("resolve failed: empty endpoint list host={} port={}", cfg_.host,
-                          cfg_.port);
-    co_return unexpected(client_errc::resolve_failed);
+  if (!connected) {
+    co_return unexpected(std::move(connected.error()));
   }
-  REDISCORO_LOG_DEBUG("resolve succeeded: endpoint_count={}", res->size());
 
   if (tok.stop_requested()) {
     co_return unexpected(client_errc::operation_aborted);
   }
 
-  // TCP connect with timeout (iterate endpoints in order).
-  std::error_code connect_ec{};
-  std::size_t endpoint_index = 0;
-  for (auto const& ep : *res) {
-    ++endpoint_index;
-    REDISCORO_LOG_DEBUG("tcp connect attempt: index={} total={}", endpoint_index, res->size());
-    // IMPORTANT: after a failed connect attempt, the socket may be left in a platform-dependent
-    // error state. Always close before trying the next endpoint.
-    if (socket_.is_open()) {
-      (void)socket_.close();
-    }
+  auto req = make_handshake_request();
+  auto slot = std::make_shared<pending_dynamic_response<ignore_t>>(req.reply_count());
 
-    auto connect_op = socket_.async_connect(ep);
-    if (cfg_.connect_timeout.has_value()) {
-      connect_op = iocoro::with_timeout(std::move(connect_op), *cfg_.connect_timeout);
-    }
-    auto connect_res = co_await std::move(connect_op);
-    if (connect_res) {
-      auto no_delay_res =
-        socket_.set_option(iocoro::socket_option::tcp::no_delay{cfg_.socket.no_delay});
-      if (!no_delay_res) {
-        REDISCORO_LOG_DEBUG("tcp set_option(TCP_NODELAY) failed: index={} err_code={} err_msg={}",
-                            endpoint_index, no_delay_res.error().value(),
-                            no_delay_res.error().message());
-        connect_ec = no_delay_res.error();
-        (void)socket_.close();
-        continue;
-      }
+  // Ahead of every queued user request and exempt from their limits.
+  pipeline_.push_internal(std::move(req), slot);
 
-      auto keep_alive_res =
-        socket_.set_option(iocoro::socket_option::keep_alive{cfg_.socket.keep_alive});
-      if (!keep_alive_res) {
-        REDISCORO_LOG_DEBUG("tcp set_option(SO_KEEPALIVE) failed: index={} err_code={} err_msg={}",
-                            endpoint_index, keep_alive_res.error().value(),
-                            keep_alive_res.error().message());
-        connect_ec = keep_alive_res.error();
-        (void)socket_.close();
-        continue;
-      }
+  // Pipelined handshake: requests queued while connecting are written right behind the handshake
+  // commands. Not behind SELECT: if it failed they would run against the default database.
+  bool const pipelined = cfg_.pipelined_handshake && cfg_.database == 0 && pipeline_.has_deferred();
+  if (pipelined) {
+    REDISCORO_LOG_DEBUG("handshake pipelining queued requests: pending={}",
+                        pipeline_.pending_count());
+    pipeline_.release_deferred();
+  }
 
-      REDISCORO_LOG_DEBUG("tcp connect attempt succeeded: index={}", endpoint_index);
-      connect_ec = {};
-      break;
-    }
-    REDISCORO_LOG_DEBUG("tcp connect attempt failed: index={} err_code={} err_msg={}",
-                        endpoint_index, connect_res.error().value(), connect_res.error().message());
-    connect_ec = connect_res.error();
-  }
-
-  if (connect_ec) {
-    REDISCORO_LOG_WARNING("tcp connect failed: attempts={} err_code={} err_msg={}", endpoint_index,
-                          connect_ec.value(), connect_ec.message());
-    // Map timeout/cancel vs generic connect failure.
-    if (connect_ec == iocoro::error::timed_out) {
-      co_return unexpected(client_errc::connect_timeout);
-    } else if (connect_ec == iocoro::error::operation_aborted) {
-      co_return unexpected(client_errc::operation_aborted);
-    } else {
-      error_info out{client_errc::connect_failed, connect_ec.message()};
-      co_return unexpected(out);
+  // Drive handshake IO directly (read/write loops are gated on OPEN so they will not interfere).
+  auto handshake = co_await run_handshake(socket_, pipeline_, parser_, slot);
+  if (!handshake) {
+    if (pipelined) {
+      // The server ran whatever reached it behind the failed handshake (a rejected HELLO or AUTH
+      // does not stop it): those requests must neither look unexecuted nor be replayed.
+      auto const unknown = pipeline_.fail_awaiting(
+        error_info{client_errc::outcome_unknown,
+                   "written behind a failed handshake: " + handshake.error().to_string()});
+      REDISCORO_LOG_WARNING("handshake failed with pipelined requests written: count={}",
+                            unknown);
     }
+    fail_pipeline(handshake.error());
+    co_return unexpected(std::move(handshake.error()));
   }
 
-  if (tok.stop_requested()) {
-    co_return unexpected(client_errc::operation_aborted);
+  // Handshake succeeded.
+  enter_open(connection_event_stage::handshake, "handshake_ok");
+
+  if (pipeline_.has_pending_read()) {
+    // Pipelined requests: their replies may already be buffered; read_loop parses them first.
+    parse_buffered_ = true;
+  } else {
+    // Defensive: ensure parser buffer/state is clean when handing over to runtime loops.
+    parser_.reset();
   }
+  co_return expected<void, error_info>{};
+}
 
+inline auto connection::make_handshake_request() const -> request {
   // Build handshake request (pipeline of commands).
   request req{};
   req.push("HELLO", "3");
@@ -147,24 +137,21 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
   }
   REDISCORO_LOG_DEBUG("handshake request built: commands={} wire_bytes={}", req.command_count(),
                       req.wire().size());
+  return req;
+}
 
-  auto slot = std::make_shared<pending_dynamic_response<ignore_t>>(req.reply_count());
-
-  if (!pipeline_.push(std::move(req), slot)) {
-    auto const ec = make_error_code(client_errc::queue_full);
-    REDISCORO_LOG_WARNING("handshake enqueue failed: err_code={} err_msg={}", ec.value(),
-                          ec.message());
-    co_return unexpected(client_errc::queue_full);
-  }
-
-  // Drive handshake IO directly (read/write loops are gated on OPEN so they will not interfere).
+inline auto connection::run_handshake(iocoro::ip::tcp::socket& sock, pipeline& pl,
+                                      resp3::parser& parser,
+                                      std::shared_ptr<pending_dynamic_response<ignore_t>> slot)
+  -> iocoro::awaitable<expected<void, error_info>> {
+  auto tok = co_await iocoro::this_coro::stop_token;
   auto do_handshake = [&]() -> iocoro::awaitable<iocoro::result<void>> {
-    // Phase-1: flush the full handshake request first.
+    // Phase-1: flush the full handshake request first (with any pipelined requests behind it).
     // Handshake generates no additional writes after the initial request is fully sent.
-    while (!tok.stop_requested() && pipeline_.has_pending_write()) {
-      auto view = pipeline_.next_write_buffer();
+    while (!tok.stop_requested() && pl.has_pending_write()) {
+      auto view = pl.next_write_buffer();
       auto buf = std::as_bytes(std::span{view.data(), view.size()});
-      auto w = co_await socket_.async_write_some(buf);
+      auto w = co_await sock.async_write_some(buf);
       if (!w) {
         if (w.error() == iocoro::error::operation_aborted) {
           co_return unexpected(client_errc::operation_aborted);
@@ -172,13 +159,14 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
         co_return unexpected(client_errc::handshake_failed);
       }
       REDISCORO_LOG_DEBUG("handshake write: bytes={}", *w);
-      pipeline_.on_write_done(*w);
+      pl.on_write_done(*w);
     }
 
     // Phase-2: read/parse until the handshake sink completes.
+    // Replies of pipelined requests stay in the parser buffer until the handshake is validated.
     while (!tok.stop_requested() && !slot->is_complete()) {
-      auto writable = parser_.prepare();
-      auto r = co_await socket_.async_read_some(writable);
+      auto writable = parser.prepare();
+      auto r = co_await sock.async_read_some(writable);
       if (!r) {
         if (r.error() == iocoro::error::operation_aborted) {
           co_return unexpected(client_errc::operation_aborted);
@@ -190,16 +178,16 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
         co_return unexpected(client_errc::connection_reset);
       }
       REDISCORO_LOG_DEBUG("handshake read: bytes={}", *r);
-      parser_.commit(*r);
+      parser.commit(*r);
 
       for (;;) {
-        auto parsed = parser_.parse_one();
+        auto parsed = parser.parse_one();
         if (!parsed) {
           auto const ec = make_error_code(parsed.error());
           REDISCORO_LOG_WARNING("handshake parse failed: err_code={} err_msg={}", ec.value(),
                                 ec.message());
-          if (pipeline_.has_pending_read()) {
-            pipeline_.on_error(parsed.error());
+          if (pl.has_pending_read()) {
+            pl.on_error(parsed.error());
           }
           co_return unexpected(parsed.error());
         }
@@ -207,15 +195,15 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
           break;
         }
 
-        if (!pipeline_.has_pending_read()) {
+        if (!pl.has_pending_read()) {
           REDISCORO_LOG_WARNING("handshake got unsolicited message");
           co_return unexpected(client_errc::unsolicited_message);
         }
 
         auto const root = **parsed;
-        auto msg = resp3::build_message(parser_.tree(), root);
-        pipeline_.on_message(std::move(msg));
-        parser_.reclaim();
+        auto msg = resp3::build_message(parser.tree(), root);
+        pl.on_message(std::move(msg));
+        parser.reclaim();
 
         if (slot->is_complete()) {
           REDISCORO_LOG_DEBUG("handshake reply collection complete");
@@ -245,26 +233,21 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
   if (!handshake_res) {
     REDISCORO_LOG_WARNING("handshake io failed: err_code={} err_msg={}",
                           handshake_res.error().value(), handshake_res.error().message());
-    auto fail_handshake = [&](error_info e) -> expected<void, error_info> {
-      pipeline_.clear_all(e);
-      return unexpected(std::move(e));
-    };
-
     auto const ec = handshake_res.error();
     if (ec == iocoro::error::timed_out) {
-      co_return fail_handshake(client_errc::handshake_timeout);
+      co_return unexpected(client_errc::handshake_timeout);
     }
     if (ec == iocoro::error::operation_aborted) {
-      co_return fail_handshake(client_errc::operation_aborted);
+      co_return unexpected(client_errc::operation_aborted);
     }
     if (is_protocol_error(ec)) {
-      co_return fail_handshake(static_cast<protocol_errc>(ec.value()));
+      co_return unexpected(static_cast<protocol_errc>(ec.value()));
     }
     if (is_client_error(ec)) {
-      co_return fail_handshake(static_cast<client_errc>(ec.value()));
+      co_return unexpected(static_cast<client_errc>(ec.value()));
     }
 
-    co_return fail_handshake({client_errc::handshake_failed, ec.message()});
+    co_return unexpected(error_info{client_errc::handshake_failed, ec.message()});
   }
 
   // Validate all handshake replies: any error => handshake_failed.
@@ -273,9 +256,7 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
   // check to avoid future hangs if the handshake loop logic changes.
   if (!slot->is_complete()) {
     REDISCORO_LOG_WARNING("handshake failed: slot incomplete");
-    error_info e{client_errc::handshake_failed, "handshake slot incomplete"};
-    pipeline_.clear_all(e);
-    co_return unexpected(e);
+    co_return unexpected(error_info{client_errc::handshake_failed, "handshake slot incomplete"});
   }
   auto results = co_await slot->wait();
   for (std::size_t i = 0; i < results.size(); ++i) {
@@ -293,28 +274,356 @@ inline auto connection::do_connect() -> iocoro::awaitable<expected<void, error_i
       error_info out{client_errc::handshake_failed, err.to_string()};
       REDISCORO_LOG_WARNING("handshake reply error: index={} err_code={} err_msg={} detail={}", i,
                             out.code.value(), out.code.message(), out.detail);
-      pipeline_.clear_all(out);
       co_return unexpected(out);
     }
   }
 
-  // Handshake succeeded.
+  co_return expected<void, error_info>{};
+}
+
+inline auto connection::enter_open(connection_event_stage stage, std::string_view reason)
+  -> void {
   auto const from = state_;
-  REDISCORO_LOG_INFO("state transition: reason=handshake_ok from={} to={} generation={}",
+  REDISCORO_LOG_INFO("state transition: reason={} from={} to={} generation={}", reason,
                      to_string(from), to_string(connection_state::OPEN), generation_ + 1);
   set_state(connection_state::OPEN);
   reconnect_count_ = 0;
   generation_ += 1;
+  // A PING still held by the previous generation was failed with it.
+  health_probe_.reset();
+  health_idle_since_ = pipeline::clock::now();
+  metrics_.connects.add();
+  if (from != connection_state::CONNECTING) {
+    metrics_.reconnects.add();
+  }
   emit_connection_event(connection_event{
     .kind = connection_event_kind::connected,
-    .stage = connection_event_stage::handshake,
+    .stage = stage,
     .from_state = static_cast<std::int32_t>(from),
     .to_state = static_cast<std::int32_t>(connection_state::OPEN),
   });
 
-  // Defensive: ensure parser buffer/state is clean when handing over to runtime loops.
-  parser_.reset();
+  // Requests queued during the handshake, held back behind SELECT, or buffered while offline are
+  // written by write_loop (unless they timed out in the meantime).
+  if (pipeline_.has_deferred()) {
+    auto const expired =
+      pipeline_.fail_expired_deferred(pipeline::clock::now(), client_errc::request_timeout);
+    REDISCORO_LOG_DEBUG("releasing deferred requests: count={} expired={}",
+                        pipeline_.deferred_count(), expired);
+    metrics_.timeouts.add(expired);
+    pipeline_.release_deferred();
+    update_queue_gauges();
+  }
+}
+
+inline auto connection::open_standby() -> iocoro::awaitable<expected<void, error_info>> {
+  REDISCORO_LOG_DEBUG("standby connect begin: host={} port={}", cfg_.host, cfg_.port);
+  bool from_cache = false;
+  auto endpoints = co_await resolve_endpoints(from_cache);
+  if (!endpoints) {
+    co_return unexpected(std::move(endpoints.error()));
+  }
+  auto connected = co_await connect_endpoints(*endpoints, standby_socket_);
+  if (!connected) {
+    co_return unexpected(std::move(connected.error()));
+  }
+
+  // The standby handshakes on its own pipeline/parser: the active connection's are in use.
+  pipeline pl{};
+  resp3::parser parser{resp3::parser::limits{
+    .max_resp_bulk_bytes = cfg_.limits.resp.max_bulk_bytes,
+    .max_resp_container_len = cfg_.limits.resp.max_container_len,
+    .max_resp_line_bytes = cfg_.limits.resp.max_line_bytes,
+  }};
+  auto req = make_handshake_request();
+  auto slot = std::make_shared<pending_dynamic_response<ignore_t>>(req.reply_count());
+  (void)pl.push(std::move(req), slot);
+
+  auto handshake = co_await run_handshake(standby_socket_, pl, parser, slot);
+  if (!handshake) {
+    pl.clear_all(handshake.error());
+    (void)standby_socket_.close();
+    co_return unexpected(std::move(handshake.error()));
+  }
   co_return expected<void, error_info>{};
 }
 
+inline auto connection::resolve()
+  -> iocoro::awaitable<expected<std::vector<iocoro::ip::tcp::endpoint>, error_info>> {
+  co_return co_await resolve_host(cfg_.host, cfg_.port, cfg_.resolve_timeout);
+}
+
+inline auto connection::resolve_host(std::string host, int port,
+                                      std::optional<std::chrono::milliseconds> timeout)
+  -> iocoro::awaitable<expected<std::vector<iocoro::ip::tcp::endpoint>, error_info>> {
+  // Resolve:
+  // - iocoro resolver runs getaddrinfo on a background thread_pool and resumes on this coroutine's
+  //   executor (our strand).
+  // - Cancellation is best-effort via stop_token. It cannot interrupt an in-flight getaddrinfo()
+  //   but can prevent delivering results to the awaiting coroutine.
+  iocoro::ip::tcp::resolver resolver{};
+  auto resolve_res = resolver.async_resolve(host, std::to_string(port));
+  if (timeout.has_value()) {
+    resolve_res = iocoro::with_timeout(std::move(resolve_res), *timeout);
+  }
+  auto res = co_await std::move(resolve_res);
+  if (!res) {
+    REDISCORO_LOG_WARNING("resolve failed: host={} port={} err_code={} err_msg={}", host, port,
+                          res.error().value(), res.error().message());
+    if (res.error() == iocoro::error::timed_out) {
+      co_return unexpected(client_errc::resolve_timeout);
+    } else if (res.error() == iocoro::error::operation_aborted) {
+      co_return unexpected(client_errc::operation_aborted);
+    } else {
+      co_return unexpected(client_errc::resolve_failed);
+    }
+  }
+  if (res->empty()) {
+    REDISCORO_LOG_WARNING("resolve failed: empty endpoint list host={} port={}", host, port);
+    co_return unexpected(client_errc::resolve_failed);
+  }
+  REDISCORO_LOG_DEBUG("resolve succeeded: endpoint_count={}", res->size());
+  co_return std::move(*res);
+}
+
+inline auto connection::resolve_endpoints(bool& from_cache)
+  -> iocoro::awaitable<expected<std::vector<iocoro::ip::tcp::endpoint>, error_info>> {
+  from_cache = false;
+  if (cfg_.endpoint_cache.enabled) {
+    auto const now = std::chrono::steady_clock::now();
+    if (auto cached = endpoint_cache_.lookup(now)) {
+      REDISCORO_LOG_DEBUG("resolve served from cache: endpoint_count={} stale={}",
+                          cached->endpoints.size(), cached->stale);
+      if (cached->stale && endpoint_cache_.try_begin_refresh()) {
+        // Stopped with the connection's lifecycle, and holds only a weak reference: a resolve
+        // stuck in getaddrinfo() must not keep a closed connection alive.
+        iocoro::co_spawn(executor_.strand().executor(), stop_.get_token(),
+                         refresh_endpoints(weak_from_this(), cfg_.host, cfg_.port,
+                                           cfg_.resolve_timeout),
+                         iocoro::detached);
+      }
+      from_cache = true;
+      co_return std::move(cached->endpoints);
+    }
+  }
+
+  auto res = co_await resolve();
+  if (!res) {
+    co_return unexpected(std::move(res.error()));
+  }
+  if (cfg_.endpoint_cache.enabled) {
+    endpoint_cache_.store(*res, std::chrono::steady_clock::now());
+  }
+  co_return endpoint_cache_.order(std::move(*res));
+}
+
+inline auto connection::refresh_endpoints(std::weak_ptr<connection> weak, std::string host,
+                                           int port,
+                                           std::optional<std::chrono::milliseconds> timeout)
+  -> iocoro::awaitable<void> {
+  REDISCORO_LOG_DEBUG("endpoint cache refresh begin: host={} port={}", host, port);
+  auto res = co_await resolve_host(std::move(host), port, timeout);
+  auto self = weak.lock();
+  if (!self) {
+    co_return;  // the cache went away with the connection
+  }
+  if (res) {
+    self->endpoint_cache_.store(std::move(*res), std::chrono::steady_clock::now());
+  }
+  // On failure (or stop) keep serving the stale endpoints; the next connect retries the refresh.
+  self->endpoint_cache_.end_refresh();
+}
+
+/// Shared state of one staggered connect across several endpoints (strand-only).
+struct connect_race {
+  explicit connect_race(std::size_t n) : sockets(n) {}
+
+  std::vector<std::shared_ptr<iocoro::ip::tcp::socket>> sockets;
+  std::optional<std::size_t> winner{};
+  std::size_t started = 0;
+  std::size_t finished = 0;
+  std::error_code last_error{};
+  iocoro::condition_event progress{};
+};
+
+inline auto apply_socket_options(iocoro::ip::tcp::socket& sock, socket_options const& opts)
+  -> std::error_code {
+  auto no_delay_res = sock.set_option(iocoro::socket_option::tcp::no_delay{opts.no_delay});
+  if (!no_delay_res) {
+    REDISCORO_LOG_DEBUG("tcp set_option(TCP_NODELAY) failed: err_code={} err_msg={}",
+                        no_delay_res.error().value(), no_delay_res.error().message());
+    return no_delay_res.error();
+  }
+
+  auto keep_alive_res = sock.set_option(iocoro::socket_option::keep_alive{opts.keep_alive});
+  if (!keep_alive_res) {
+    REDISCORO_LOG_DEBUG("tcp set_option(SO_KEEPALIVE) failed: err_code={} err_msg={}",
+                        keep_alive_res.error().value(), keep_alive_res.error().message());
+    return keep_alive_res.error();
+  }
+
+  if (opts.busy_poll.has_value()) {
+    // Best-effort tuning: a refusal must not fail the connect.
+    auto const ec = set_busy_poll(sock.native_handle(), *opts.busy_poll, opts.prefer_busy_poll);
+    if (ec) {
+      REDISCORO_LOG_WARNING("tcp set_option(SO_BUSY_POLL) failed: err_code={} err_msg={}",
+                            ec.value(), ec.message());
+    }
+  }
+  return {};
+}
+
+/// One connect attempt of a `connect_race`. Claims the win if nobody connected first.
+inline auto run_connect_attempt(std::shared_ptr<connect_race> race, std::size_t index,
+                                iocoro::ip::tcp::endpoint ep,
+                                std::optional<std::chrono::milliseconds> timeout,
+                                socket_options opts) -> iocoro::awaitable<void> {
+  auto sock = race->sockets[index];
+  auto connect_op = sock->async_connect(ep);
+  if (timeout.has_value()) {
+    connect_op = iocoro::with_timeout(std::move(connect_op), *timeout);
+  }
+  auto connect_res = co_await std::move(connect_op);
+
+  std::error_code ec{};
+  if (!connect_res) {
+    ec = connect_res.error();
+  } else if (race->winner.has_value()) {
+    ec = iocoro::error::operation_aborted;  // Lost the race.
+  } else {
+    ec = apply_socket_options(*sock, opts);
+  }
+
+  if (!ec) {
+    REDISCORO_LOG_DEBUG("tcp connect attempt succeeded: index={}", index + 1);
+    race->winner = index;
+  } else {
+    REDISCORO_LOG_DEBUG("tcp connect attempt failed: index={} err_code={} err_msg={}", index + 1,
+                        ec.value(), ec.message());
+    // IMPORTANT: after a failed connect attempt, the socket may be left in a platform-dependent
+    // error state. Never reuse it.
+    (void)sock->close();
+    if (!race->winner.has_value()) {
+      race->last_error = ec;
+    }
+  }
+  race->finished += 1;
+  race->progress.notify();
+}
+
+inline auto connection::connect_endpoints(std::vector<iocoro::ip::tcp::endpoint> const& endpoints,
+                                          iocoro::ip::tcp::socket& out)
+  -> iocoro::awaitable<expected<void, error_info>> {
+  auto tok = co_await iocoro::this_coro::stop_token;
+  if (out.is_open()) {
+    (void)out.close();
+  }
+
+  // Staggered parallel connect (RFC 8305 "happy eyeballs"), endpoints in resolver order:
+  // - start the next attempt when `connect_attempt_delay` elapses or an earlier attempt fails;
+  // - the first attempt to connect wins, the others are cancelled;
+  // - every attempt is joined before returning (no attempt outlives this call).
+  // - attempts run under this call's stop token, and `close()` reaches their sockets through
+  //   `connect_races_`.
+  auto race = std::make_shared<connect_race>(endpoints.size());
+  connect_races_.push_back(race);
+  struct race_registration {
+    std::vector<std::shared_ptr<connect_race>>& races;
+    connect_race const* race;
+    ~race_registration() {
+      std::erase_if(races, [this](auto const& r) { return r.get() == race; });
+    }
+  };
+  race_registration registration{connect_races_, race.get()};
+  auto const strand = executor_.strand().executor();
+  auto start_next = [&]() {
+    auto const index = race->started++;
+    REDISCORO_LOG_DEBUG("tcp connect attempt: index={} total={}", index + 1, endpoints.size());
+    race->sockets[index] = std::make_shared<iocoro::ip::tcp::socket>(executor_.get_io_executor());
+    iocoro::co_spawn(strand, tok,
+                     run_connect_attempt(race, index, endpoints[index], cfg_.connect_timeout,
+                                         cfg_.socket),
+                     iocoro::detached);
+  };
+
+  iocoro::steady_timer timer{executor_.get_io_executor()};
+  std::size_t seen_finished = 0;
+  start_next();
+  while (!race->winner.has_value() && race->finished < endpoints.size() &&
+         !tok.stop_requested()) {
+    bool const can_start = race->started < endpoints.size();
+    if (can_start && race->finished > seen_finished) {
+      // An attempt failed: move on to the next endpoint right away.
+      seen_finished = race->finished;
+      start_next();
+      continue;
+    }
+    if (can_start && cfg_.connect_attempt_delay.has_value()) {
+      timer.expires_after(*cfg_.connect_attempt_delay);
+      auto timer_wait = timer.async_wait(iocoro::use_awaitable);
+      auto progress_wait = race->progress.async_wait();
+      auto [index, _] = co_await iocoro::when_any(std::move(timer_wait), std::move(progress_wait));
+      if (index == 0 && !race->winner.has_value() && race->finished == seen_finished) {
+        start_next();
+      }
+      continue;
+    }
+    if (!co_await race->progress.async_wait()) {
+      break;  // Wait cancelled (stop): fall through to cancelling the attempts.
+    }
+  }
+
+  // Cancel the losers (or everything, on stop) and join all attempts.
+  for (std::size_t i = 0; i < race->started; ++i) {
+    if (race->winner != i && race->sockets[i]->is_open()) {
+      (void)race->sockets[i]->close();
+    }
+  }
+  // A cancelled wait ends the join: the attempts own `race` and finish on their own, their
+  // sockets already closed.
+  bool joined = true;
+  while (race->finished < race->started) {
+    if (!co_await race->progress.async_wait()) {
+      joined = false;
+      break;
+    }
+  }
+
+  if (tok.stop_requested() || !joined) {
+    co_return unexpected(client_errc::operation_aborted);
+  }
+
+  if (race->winner.has_value()) {
+    auto const index = *race->winner;
+    out = std::move(*race->sockets[index]);
+    endpoint_cache_.remember_success(endpoints[index]);
+    REDISCORO_LOG_DEBUG("tcp connect succeeded: index={} started={}", index + 1, race->started);
+    co_return expected<void, error_info>{};
+  }
+
+  auto const connect_ec = race->last_error;
+  REDISCORO_LOG_WARNING("tcp connect failed: attempts={} err_code={} err_msg={}", race->started,
+                        connect_ec.value(), connect_ec.message());
+  // Map timeout/cancel vs generic connect failure.
+  if (connect_ec == iocoro::error::timed_out) {
+    co_return unexpected(client_errc::connect_timeout);
+  } else if (connect_ec == iocoro::error::operation_aborted) {
+    co_return unexpected(client_errc::operation_aborted);
+  } else {
+    error_info out{client_errc::connect_failed, connect_ec.message()};
+    co_return unexpected(out);
+  }
+}
+
+inline auto connection::cancel_connect_races() -> void {
+  for (auto const& race : connect_races_) {
+    for (std::size_t i = 0; i < race->started; ++i) {
+      if (race->sockets[i]->is_open()) {
+        (void)race->sockets[i]->close();
+      }
+    }
+    race->progress.notify();
+  }
+}
+
 }  // namespace rediscoro::detail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <rediscoro/detail/command_info.hpp>
 #include <rediscoro/detail/connection.hpp>
 #include <rediscoro/error_info.hpp>
 
@@ -7,8 +8,11 @@
 #include <iocoro/co_spawn.hpp>
 #include <iocoro/this_coro.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <exception>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -86,26 +90,50 @@ inline auto fail_sink_with_current_exception(std::shared_ptr<response_sink> cons
 
 inline connection::connection(iocoro::any_io_executor ex, config cfg)
     : cfg_(std::move(cfg)),
-      executor_(ex),
+      executor_(ex, cfg_.single_threaded),
+      resumer_(executor_.strand().executor()),
       socket_(executor_.get_io_executor()),
-      pipeline_(pipeline::limits{
-        .max_requests = cfg_.limits.pipeline.max_requests,
-        .max_pending_write_bytes = cfg_.limits.pipeline.max_pending_write_bytes,
+      endpoint_cache_(cfg_.endpoint_cache.ttl, cfg_.endpoint_cache.prefer_last_endpoint),
+      singleflight_(singleflight_group::limits{
+        .max_inflight_keys = cfg_.singleflight.max_inflight_keys,
+        .max_key_bytes = cfg_.singleflight.max_key_bytes,
       }),
+      pipeline_(
+        pipeline::limits{
+          .max_requests = cfg_.limits.pipeline.max_requests,
+          .max_pending_write_bytes = cfg_.limits.pipeline.max_pending_write_bytes,
+        },
+        pipeline::write_options{
+          .coalesce = cfg_.auto_pipelining.enabled,
+          .max_batch_bytes = cfg_.auto_pipelining.max_batch_bytes,
+          .max_batch_requests = cfg_.auto_pipelining.max_batch_requests,
+        }),
       parser_(resp3::parser::limits{
         .max_resp_bulk_bytes = cfg_.limits.resp.max_bulk_bytes,
         .max_resp_container_len = cfg_.limits.resp.max_container_len,
         .max_resp_line_bytes = cfg_.limits.resp.max_line_bytes,
-      }) {
+      }),
+      standby_socket_(executor_.get_io_executor()) {
   cfg_.reconnection = sanitize_reconnection_policy(cfg_.reconnection);
+  if (cfg_.slow_requests.enabled) {
+    slow_log_ = std::make_unique<slow_request_log>(cfg_.slow_requests.capacity);
+  }
+  if (cfg_.adaptive_timeout.enabled) {
+    adaptive_timeout_ = std::make_unique<adaptive_timeout>(
+      cfg_.adaptive_timeout, cfg_.request_timeout, pipeline::clock::now());
+  }
+  pipeline_.set_phase_stamping(stamps_phases());
   REDISCORO_LOG_DEBUG(
     "connection created: host={} port={} request_timeout_ms={} reconnect_enabled={} "
     "reconnect_immediate_attempts={} reconnect_initial_delay_ms={} reconnect_max_delay_ms={} "
-    "limits_max_requests={} limits_max_pending_write_bytes={}",
+    "limits_max_requests={} limits_max_pending_write_bytes={} auto_pipelining={} singleflight={} "
+    "pipelined_handshake={} offline_buffer={} standby={}",
     cfg_.host, cfg_.port, cfg_.request_timeout.has_value() ? cfg_.request_timeout->count() : -1LL,
     cfg_.reconnection.enabled, cfg_.reconnection.immediate_attempts,
     cfg_.reconnection.initial_delay.count(), cfg_.reconnection.max_delay.count(),
-    cfg_.limits.pipeline.max_requests, cfg_.limits.pipeline.max_pending_write_bytes);
+    cfg_.limits.pipeline.max_requests, cfg_.limits.pipeline.max_pending_write_bytes,
+    cfg_.auto_pipelining.enabled, cfg_.singleflight.enabled, cfg_.pipelined_handshake,
+    cfg_.offline_buffer.enabled, cfg_.standby.enabled);
 }
 
 inline connection::~connection() noexcept {
@@ -130,10 +158,14 @@ inline connection::~connection() noexcept {
   if (socket_.is_open()) {
     (void)socket_.close();
   }
+  if (standby_socket_.is_open()) {
+    (void)standby_socket_.close();
+  }
 
   write_wakeup_.notify();
   read_wakeup_.notify();
   control_wakeup_.notify();
+  standby_wakeup_.notify();
 }
 
 inline auto connection::run_actor() -> void {
@@ -174,6 +206,7 @@ inline auto connection::run_actor() -> void {
             });
           }
           self->pipeline_.clear_all(err);
+          self->dump_slow_requests();
           if (self->socket_.is_open()) {
             (void)self->socket_.close();
           }
@@ -243,6 +276,10 @@ inline auto connection::connect() -> iocoro::awaitable<expected<void, error_info
       .to_state = static_cast<std::int32_t>(connection_state::CLOSING),
       .error = connect_res.error(),
     });
+    // Requests queued for a pipelined handshake fail with the connect error, not
+    // connection_closed.
+    pipeline_.clear_all(connect_res.error());
+    dump_slow_requests();
     // Initial connect failure MUST NOT enter FAILED state (FAILED is reserved for runtime errors).
     // Cleanup is unified via close() (joins the actor).
     co_await close();
@@ -260,6 +297,15 @@ inline auto connection::connect() -> iocoro::awaitable<expected<void, error_info
   co_return expected<void, error_info>{};
 }
 
+inline auto connection::adaptive_timeout_for(std::string verb)
+  -> iocoro::awaitable<std::optional<std::chrono::nanoseconds>> {
+  co_await iocoro::this_coro::switch_to(executor_.strand().executor());
+  if (adaptive_timeout_ == nullptr) {
+    co_return std::nullopt;
+  }
+  co_return adaptive_timeout_->class_timeout(verb);
+}
+
 inline auto connection::close() -> iocoro::awaitable<void> {
   co_await iocoro::this_coro::switch_to(executor_.strand().executor());
   REDISCORO_LOG_DEBUG("close requested: state={}", to_string(state_));
@@ -277,16 +323,23 @@ inline auto connection::close() -> iocoro::awaitable<void> {
 
   // Fail all pending work deterministically.
   pipeline_.clear_all(client_errc::connection_closed);
+  update_queue_gauges();
+  dump_slow_requests();
 
-  // Close socket immediately.
+  // Close sockets immediately (also aborts a standby handshake in progress).
   if (socket_.is_open()) {
     (void)socket_.close();
   }
+  if (standby_socket_.is_open()) {
+    (void)standby_socket_.close();
+  }
+  cancel_connect_races();
 
   // Wake loops / actor.
   write_wakeup_.notify();
   read_wakeup_.notify();
   control_wakeup_.notify();
+  standby_wakeup_.notify();
 
   if (actor_running_) {
     REDISCORO_LOG_DEBUG("close waiting for actor to finish");
@@ -300,23 +353,49 @@ inline auto connection::close() -> iocoro::awaitable<void> {
 
 inline auto connection::enqueue_impl(request req, std::shared_ptr<response_sink> sink,
                                      std::chrono::steady_clock::time_point start) -> void {
+  if (admit(std::move(req), std::move(sink), start)) {
+    write_wakeup_.notify();
+    // request_timeout scheduling / wake control_loop when first request arrives
+    control_wakeup_.notify();
+  }
+}
+
+inline auto connection::admit(request req, std::shared_ptr<response_sink> sink,
+                              std::chrono::steady_clock::time_point start) -> bool {
   REDISCORO_ASSERT(sink != nullptr);
   REDISCORO_LOG_DEBUG("enqueue received: state={} command_count={} wire_bytes={}",
                       to_string(state_), req.command_count(), req.wire().size());
+  REDISCORO_PROBE3(enqueue, this, req.wire().size(), req.command_count());
 
   auto const hooks = cfg_.trace_hooks;  // copy: stable for the sink and callbacks
-  const bool tracing = hooks.enabled();
+  const bool tracing =
+    hooks.enabled() && (hooks.sample_every <= 1 || trace_sample_count_++ % hooks.sample_every == 0);
+  auto* const latency = cfg_.latency.get();
+
+  auto* const slow_log = slow_log_.get();
+  auto const accepted_at = ((tracing && hooks.on_phases != nullptr) || slow_log != nullptr)
+                             ? std::chrono::steady_clock::now()
+                             : std::chrono::steady_clock::time_point{};
 
   request_trace_info trace_info{};
-  if (tracing) {
+  if (tracing || slow_log != nullptr) {
     trace_info = request_trace_info{
-      .id = next_request_id_++,
+      .id = tracing ? next_request_id_++ : 0,
       .kind = request_kind::user,
       .command_count = req.command_count(),
       .wire_bytes = req.wire().size(),
+      .command = trace_label::from(first_command_verb(req.wire())),
     };
+    for (std::size_t i = 0; i < trace_info.command.size; ++i) {
+      trace_info.command.data[i] = ascii_upper(trace_info.command.data[i]);
+    }
+    if (tracing && hooks.capture_key) {
+      auto const key = first_command_key(req.wire());
+      trace_info.key_hash = key.empty() ? 0 : trace_key_hash(key);
+      trace_info.key = trace_label::from(key.substr(0, hooks.key_prefix_bytes));
+    }
 
-    if (hooks.on_start != nullptr) {
+    if (tracing && hooks.on_start != nullptr) {
       request_trace_start evt{.info = trace_info};
       try {
         hooks.on_start(hooks.user_data, evt);
@@ -354,46 +433,141 @@ inline auto connection::enqueue_impl(request req, std::shared_ptr<response_sink>
                               trace_info.id, to_string(trace_info.kind));
       }
     }
+    REDISCORO_PROBE2(reject, this, err.code.value());
+    metrics_.requests_rejected.add();
+    if (err.code == make_error_code(client_errc::queue_full)) {
+      metrics_.queue_full_rejections.add();
+    }
     sink->fail_all(std::move(err));
   };
 
   // State gating: reject early if not ready.
+  bool defer = false;
   switch (state_) {
-    case connection_state::INIT:
     case connection_state::CONNECTING: {
+      if (cfg_.pipelined_handshake) {
+        // Held back until the handshake is queued (see do_connect()).
+        defer = true;
+        break;
+      }
+      reject(client_errc::not_connected, "not_connected", log_level::debug);
+      return false;
+    }
+    case connection_state::INIT: {
       reject(client_errc::not_connected, "not_connected", log_level::debug);
-      return;
+      return false;
     }
     case connection_state::FAILED:
     case connection_state::RECONNECTING: {
+      if (offline_buffering()) {
+        auto const& bounds = cfg_.offline_buffer;
+        auto const bytes = req.wire().size();
+        if (pipeline_.deferred_count() >= bounds.max_requests || bytes > bounds.max_bytes ||
+            pipeline_.deferred_bytes() > bounds.max_bytes - bytes) {
+          reject(client_errc::queue_full, "offline_buffer_full", log_level::warning);
+          return false;
+        }
+        // Held back until the connection is re-established (see do_connect()).
+        defer = true;
+        break;
+      }
       reject(client_errc::connection_lost, "connection_lost", log_level::debug);
-      return;
+      return false;
     }
     case connection_state::CLOSING:
     case connection_state::CLOSED: {
       reject(client_errc::connection_closed, "connection_closed", log_level::debug);
-      return;
+      return false;
     }
     case connection_state::OPEN: {
       break;
     }
   }
 
+  bool const read_only = (cfg_.singleflight.enabled || cfg_.offline_buffer.enabled) &&
+                         all_commands_have(req.wire(), command_flags::read_only);
+  // Idempotent: safe to send again after a connection loss even if it was already written.
+  bool const replayable = read_only && cfg_.offline_buffer.replay_reads;
+
+  // Key tracking copies the verb and first key while the wire bytes are still at hand.
+  std::unique_ptr<key_sample> sampled_key{};
+  if (auto* const keys = cfg_.key_tracking.get(); keys != nullptr) {
+    auto const every = keys->options().sample_every;
+    if (every <= 1 || key_sample_count_++ % every == 0) {
+      sampled_key = key_sample::from(keys, req.wire());
+    }
+  }
+
+  // Singleflight: share the round trip of an identical in-flight read-only request.
+  std::shared_ptr<singleflight_sink> flight{};
+  if (cfg_.singleflight.enabled && read_only) {
+    if (singleflight_.try_join(req.wire(), sink)) {
+      REDISCORO_LOG_DEBUG("enqueue joined in-flight request: wire_bytes={}", req.wire().size());
+      metrics_.requests_accepted.add();
+      metrics_.requests_deduplicated.add();
+      if (tracing) {
+        sink->set_trace_context(hooks, trace_info, start, accepted_at);
+      }
+      if (latency != nullptr) {
+        sink->set_latency_target(latency->target_for(req.wire()), start);
+      }
+      sink->set_key_sample(std::move(sampled_key));
+      if (slow_log != nullptr) {
+        sink->set_slow_request_log(slow_log, cfg_.slow_requests.threshold, generation_, trace_info,
+                                   start, accepted_at);
+      }
+      return false;  // Nothing new to write.
+    }
+    flight = singleflight_.lead(req.wire(), sink);
+  }
+
+  // Resolved before the request moves into the pipeline (the verb is read from its wire bytes).
+  auto const latency_target =
+    latency != nullptr ? latency->target_for(req.wire()) : latency_recorder::target{};
+
   pipeline::time_point deadline = pipeline::time_point::max();
-  if (cfg_.request_timeout.has_value()) {
+  latency_histogram* timeout_window = nullptr;
+  if (adaptive_timeout_ != nullptr) {
+    auto const now = pipeline::clock::now();
+    auto const budget = adaptive_timeout_->budget_for(req.wire(), req.command_count(), now);
+    if (budget.timeout.has_value()) {
+      // Never ahead of a request queued earlier: its reply comes first anyway.
+      deadline = std::max(now + *budget.timeout, pipeline_.last_deadline());
+    }
+    timeout_window = budget.window;
+  } else if (cfg_.request_timeout.has_value()) {
     deadline = pipeline::clock::now() + *cfg_.request_timeout;
   }
-  if (!pipeline_.push(std::move(req), sink, deadline)) {
+  std::shared_ptr<response_sink> pipeline_sink = flight ? flight : sink;
+  auto const accepted =
+    defer ? pipeline_.defer(std::move(req), std::move(pipeline_sink), deadline, replayable)
+          : pipeline_.push(std::move(req), std::move(pipeline_sink), deadline, replayable);
+  if (!accepted) {
+    if (flight) {
+      singleflight_.abandon(flight);
+    }
     reject(client_errc::queue_full, "queue_full", log_level::warning);
-    return;
+    return false;
   }
-  REDISCORO_LOG_DEBUG("enqueue accepted: expected_replies={}", sink->expected_replies());
+  REDISCORO_LOG_DEBUG("enqueue accepted: expected_replies={} deferred={}",
+                      sink->expected_replies(), defer);
+  metrics_.requests_accepted.add();
+  update_queue_gauges();
   if (tracing) {
-    sink->set_trace_context(hooks, trace_info, start);
+    sink->set_trace_context(hooks, trace_info, start, accepted_at);
   }
-  write_wakeup_.notify();
-  // request_timeout scheduling / wake control_loop when first request arrives
-  control_wakeup_.notify();
+  if (latency != nullptr) {
+    sink->set_latency_target(latency_target, start);
+  }
+  if (timeout_window != nullptr) {
+    sink->set_timeout_window(timeout_window, start);
+  }
+  sink->set_key_sample(std::move(sampled_key));
+  if (slow_log != nullptr) {
+    sink->set_slow_request_log(slow_log, cfg_.slow_requests.threshold, generation_, trace_info,
+                               start, accepted_at);
+  }
+  return true;
 }
 
 inline auto connection::emit_connection_event(connection_event evt) noexcept -> void {
@@ -424,6 +598,7 @@ inline auto connection::transition_to_closed() -> void {
   set_state(connection_state::CLOSED);
 
   pipeline_.clear_all(client_errc::connection_closed);
+  update_queue_gauges();
 
   if (socket_.is_open()) {
     (void)socket_.close();
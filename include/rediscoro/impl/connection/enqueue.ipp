@@ -2,8 +2,10 @@
 
 #include <rediscoro/detail/connection.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace rediscoro::detail {
 
@@ -11,13 +13,15 @@ template <typename... Ts>
 inline auto connection::enqueue(request req) -> std::shared_ptr<pending_response<Ts...>> {
   REDISCORO_ASSERT(req.reply_count() == sizeof...(Ts));
   auto slot = std::make_shared<pending_response<Ts...>>();
+  if (cfg_.inline_resume) {
+    slot->set_resume_queue(&resumer_);
+  }
   REDISCORO_LOG_DEBUG(
     "enqueue api fixed request: command_count={} wire_bytes={} expected_replies={}",
     req.command_count(), req.wire().size(), sizeof...(Ts));
 
-  const bool need_trace = cfg_.trace_hooks.enabled();
-  const auto start =
-    need_trace ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+  const auto start = stamps_submission() ? std::chrono::steady_clock::now()
+                                         : std::chrono::steady_clock::time_point{};
 
   // Thread-safety: enqueue() may be called from any executor/thread.
   // All state_ / pipeline_ mutation must happen on the connection strand.
@@ -41,13 +45,15 @@ template <typename T>
 inline auto connection::enqueue_dynamic(request req)
   -> std::shared_ptr<pending_dynamic_response<T>> {
   auto slot = std::make_shared<pending_dynamic_response<T>>(req.reply_count());
+  if (cfg_.inline_resume) {
+    slot->set_resume_queue(&resumer_);
+  }
   REDISCORO_LOG_DEBUG(
     "enqueue api dynamic request: command_count={} wire_bytes={} expected_replies={}",
     req.command_count(), req.wire().size(), req.reply_count());
 
-  const bool need_trace = cfg_.trace_hooks.enabled();
-  const auto start =
-    need_trace ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+  const auto start = stamps_submission() ? std::chrono::steady_clock::now()
+                                         : std::chrono::steady_clock::time_point{};
 
   // Thread-safety: enqueue_dynamic() may be called from any executor/thread.
   // All state_ / pipeline_ mutation must happen on the connection strand.
@@ -64,4 +70,77 @@ inline auto connection::enqueue_dynamic(request req)
   return slot;
 }
 
+template <typename T>
+inline auto connection::enqueue_stream(request req, std::size_t max_buffered)
+  -> std::shared_ptr<stream_sink<T>> {
+  auto slot = std::make_shared<stream_sink<T>>(req.reply_count(), max_buffered);
+  // The consumer wakes a reader paused by backpressure; the stream may outlive the connection.
+  slot->set_resume_reader([weak = weak_from_this()]() {
+    if (auto self = weak.lock()) {
+      self->read_wakeup_.notify();
+    }
+  });
+  REDISCORO_LOG_DEBUG("enqueue api stream request: command_count={} wire_bytes={} max_buffered={}",
+                      req.command_count(), req.wire().size(), max_buffered);
+
+  const auto start = stamps_submission() ? std::chrono::steady_clock::now()
+                                         : std::chrono::steady_clock::time_point{};
+
+  executor_.strand().executor().dispatch(
+    [self = shared_from_this(), req = std::move(req), slot, start]() mutable {
+      try {
+        self->enqueue_impl(std::move(req), slot, start);
+      } catch (...) {
+        REDISCORO_LOG_ERROR("enqueue api stream dispatch exception");
+        fail_sink_with_current_exception(slot, "enqueue_stream dispatch");
+      }
+    });
+
+  return slot;
+}
+
+template <typename T>
+inline auto connection::enqueue_batch(std::vector<request> reqs)
+  -> std::vector<std::shared_ptr<pending_dynamic_response<T>>> {
+  std::vector<std::shared_ptr<pending_dynamic_response<T>>> slots{};
+  slots.reserve(reqs.size());
+  for (auto const& req : reqs) {
+    auto slot = std::make_shared<pending_dynamic_response<T>>(req.reply_count());
+    if (cfg_.inline_resume) {
+      slot->set_resume_queue(&resumer_);
+    }
+    slots.push_back(std::move(slot));
+  }
+  REDISCORO_LOG_DEBUG("enqueue api batch: requests={}", reqs.size());
+  if (reqs.empty()) {
+    return slots;
+  }
+
+  const auto start = stamps_submission() ? std::chrono::steady_clock::now()
+                                         : std::chrono::steady_clock::time_point{};
+
+  // One strand crossing for the whole batch; the loops are woken once at the end.
+  executor_.strand().executor().dispatch(
+    [self = shared_from_this(), reqs = std::move(reqs), slots, start]() mutable {
+      bool any_queued = false;
+      std::size_t i = 0;
+      try {
+        for (; i < reqs.size(); ++i) {
+          any_queued = self->admit(std::move(reqs[i]), slots[i], start) || any_queued;
+        }
+      } catch (...) {
+        REDISCORO_LOG_ERROR("enqueue api batch dispatch exception: index={}", i);
+        for (; i < slots.size(); ++i) {
+          fail_sink_with_current_exception(slots[i], "enqueue_batch dispatch");
+        }
+      }
+      if (any_queued) {
+        self->write_wakeup_.notify();
+        self->control_wakeup_.notify();
+      }
+    });
+
+  return slots;
+}
+
 }  // namespace rediscoro::detail
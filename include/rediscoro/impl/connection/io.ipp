@@ -3,12 +3,25 @@
 #include <rediscoro/detail/connection.hpp>
 #include <rediscoro/resp3/builder.hpp>
 
+#include <iocoro/condition_event.hpp>
 #include <iocoro/this_coro.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <span>
+#include <string>
+#include <utility>
 
 namespace rediscoro::detail {
 
+/// Map a non-blocking read onto the `async_read_some` result shape (0 bytes = EOF).
+inline auto to_read_result(nonblocking_read_result const& r) -> iocoro::result<std::size_t> {
+  if (r.status == nonblocking_read_status::error) {
+    return unexpected(r.error);
+  }
+  return r.bytes;
+}
+
 inline auto connection::do_read() -> iocoro::awaitable<void> {
   if (state_ != connection_state::OPEN) {
     co_return;
@@ -16,77 +29,162 @@ inline auto connection::do_read() -> iocoro::awaitable<void> {
 
   struct in_flight_guard {
     bool& flag;
-    explicit in_flight_guard(bool& f) : flag(f) {
+    iocoro::condition_event& idle;
+    in_flight_guard(bool& f, iocoro::condition_event& e) : flag(f), idle(e) {
       REDISCORO_ASSERT(!flag, "concurrent read detected");
       flag = true;
     }
-    ~in_flight_guard() { flag = false; }
+    ~in_flight_guard() {
+      flag = false;
+      idle.notify();
+    }
   };
 
-  in_flight_guard guard{read_in_flight_};
+  in_flight_guard guard{read_in_flight_, io_idle_};
 
   // Socket-driven read: perform one read operation (may parse multiple messages from the buffer).
   // This allows detecting peer close even when no pending_read exists.
-  auto writable = parser_.prepare();
-  auto r = co_await socket_.async_read_some(writable);
+  // Exception: bytes the handshake read past its own replies are parsed first (pipelined
+  // handshake); the next call reads from the socket again.
+  if (!std::exchange(parse_buffered_, false)) {
+    auto writable = parser_.prepare();
+    iocoro::result<std::size_t> r{};
+    if (auto const spun = spin_read(writable);
+        spun.status == nonblocking_read_status::would_block) {
+      r = co_await socket_.async_read_some(writable);
+    } else {
+      r = to_read_result(spun);
+    }
+    if (!on_read_complete(r)) {
+      co_return;
+    }
+  }
+
+  // Waiters completed while dispatching these bytes are resumed inline once dispatch finishes
+  // (inline_resume only). Opened after the read: while it is pending, completions from other
+  // paths (rejections, timeouts) must still be posted.
+  resume_queue::batch resume_batch{resumer_};
+
+  for (std::size_t reads_ahead = 0;; ++reads_ahead) {
+    for (;;) {
+      auto parsed = parser_.parse_one();
+      if (!parsed) {
+        auto const ec = make_error_code(parsed.error());
+        // Deliver parser error into the pipeline, then treat it as a fatal connection error.
+        if (pipeline_.has_pending_read()) {
+          pipeline_.on_error(parsed.error());
+        }
+        REDISCORO_LOG_WARNING("runtime parse failed: err_code={} err_msg={}", ec.value(),
+                              ec.message());
+        handle_error(parsed.error());
+        co_return;
+      }
+      if (!parsed->has_value()) {
+        break;
+      }
+
+      if (!pipeline_.has_pending_read()) {
+        // Unsolicited message (e.g. PUSH) is not supported yet.
+        // Temporary policy: treat as "unsupported feature" rather than protocol violation.
+        REDISCORO_LOG_WARNING("runtime received unsolicited message");
+        handle_error(client_errc::unsolicited_message);
+        co_return;
+      }
+
+      REDISCORO_PROBE2(parse, this, parser_.message_bytes());
+      auto const root = **parsed;
+      auto msg = resp3::build_message(parser_.tree(), root);
+      if (stamps_phases()) {
+        pipeline_.stamp_reply(last_read_at_, pipeline::clock::now());
+      }
+      if (cfg_.key_tracking != nullptr || slow_log_ != nullptr) {
+        pipeline_.add_reply_bytes(parser_.message_bytes());
+      }
+      pipeline_.on_message(std::move(msg));
+      REDISCORO_PROBE2(deliver, this, pipeline_.pending_count());
+      metrics_.messages_parsed.add();
+      if (health_probe_ != nullptr && health_probe_->is_complete()) {
+        finish_health_probe();
+      }
+      update_queue_gauges();
+      REDISCORO_LOG_DEBUG("runtime message delivered to pipeline");
+
+      // Critical for zero-copy parser: reclaim before parsing the next message.
+      parser_.reclaim();
+
+      if (pipeline_.read_paused()) {
+        // Backpressure: keep the remaining bytes buffered until the consumer catches up.
+        REDISCORO_LOG_DEBUG("runtime read paused by stream backpressure");
+        parse_buffered_ = true;
+        co_return;
+      }
+    }
+
+    // Opportunistic read-ahead: while replies are still outstanding, drain bytes that are
+    // already in the kernel buffer without another trip through the reactor.
+    if (!cfg_.read_ahead.enabled || reads_ahead >= cfg_.read_ahead.max_reads ||
+        state_ != connection_state::OPEN || !pipeline_.has_pending_read()) {
+      break;
+    }
+    auto const more = try_read_nonblocking(socket_.native_handle(), parser_.prepare());
+    if (more.status == nonblocking_read_status::would_block) {
+      break;
+    }
+    if (!on_read_complete(to_read_result(more))) {
+      co_return;
+    }
+  }
+
+  co_return;
+}
+
+inline auto connection::on_read_complete(iocoro::result<std::size_t> const& r) -> bool {
+  metrics_.read_ops.add();
   if (!r) {
     if (r.error() == iocoro::error::operation_aborted &&
         (state_ == connection_state::CLOSING || state_ == connection_state::CLOSED)) {
       REDISCORO_LOG_DEBUG("runtime read cancelled during shutdown");
-      co_return;
+      return false;
     }
     // Socket IO error - treat as connection lost
     REDISCORO_LOG_WARNING("runtime read failed: err_code={} err_msg={}", r.error().value(),
                           r.error().message());
     handle_error(client_errc::connection_lost);
-    co_return;
+    return false;
   }
 
   if (*r == 0) {
     // Peer closed (EOF).
     REDISCORO_LOG_WARNING("runtime read eof");
     handle_error(client_errc::connection_reset);
-    co_return;
+    return false;
   }
 
   REDISCORO_LOG_DEBUG("runtime read: bytes={}", *r);
+  metrics_.bytes_read.add(*r);
+  if (stamps_phases()) {
+    last_read_at_ = pipeline::clock::now();
+  }
   parser_.commit(*r);
+  return true;
+}
 
-  for (;;) {
-    auto parsed = parser_.parse_one();
-    if (!parsed) {
-      auto const ec = make_error_code(parsed.error());
-      // Deliver parser error into the pipeline, then treat it as a fatal connection error.
-      if (pipeline_.has_pending_read()) {
-        pipeline_.on_error(parsed.error());
-      }
-      REDISCORO_LOG_WARNING("runtime parse failed: err_code={} err_msg={}", ec.value(),
-                            ec.message());
-      handle_error(parsed.error());
-      co_return;
-    }
-    if (!parsed->has_value()) {
-      break;
-    }
+inline auto connection::spin_read(std::span<std::byte> buf) -> nonblocking_read_result {
+  if (!cfg_.read_spin.enabled || !pipeline_.has_pending_read()) {
+    return {};
+  }
 
-    if (!pipeline_.has_pending_read()) {
-      // Unsolicited message (e.g. PUSH) is not supported yet.
-      // Temporary policy: treat as "unsupported feature" rather than protocol violation.
-      REDISCORO_LOG_WARNING("runtime received unsolicited message");
-      handle_error(client_errc::unsolicited_message);
-      co_return;
+  // Runs without yielding: nothing else on this executor makes progress until it returns.
+  auto const fd = socket_.native_handle();
+  auto const deadline = std::chrono::steady_clock::now() + cfg_.read_spin.budget;
+  for (;;) {
+    auto res = try_read_nonblocking(fd, buf);
+    if (res.status != nonblocking_read_status::would_block ||
+        std::chrono::steady_clock::now() >= deadline) {
+      return res;
     }
-
-    auto const root = **parsed;
-    auto msg = resp3::build_message(parser_.tree(), root);
-    pipeline_.on_message(std::move(msg));
-    REDISCORO_LOG_DEBUG("runtime message delivered to pipeline");
-
-    // Critical for zero-copy parser: reclaim before parsing the next message.
-    parser_.reclaim();
+    cpu_relax();
   }
-
-  co_return;
 }
 
 inline auto connection::do_write() -> iocoro::awaitable<void> {
@@ -96,14 +194,18 @@ inline auto connection::do_write() -> iocoro::awaitable<void> {
 
   struct in_flight_guard {
     bool& flag;
-    explicit in_flight_guard(bool& f) : flag(f) {
+    iocoro::condition_event& idle;
+    in_flight_guard(bool& f, iocoro::condition_event& e) : flag(f), idle(e) {
       REDISCORO_ASSERT(!flag, "concurrent write detected");
       flag = true;
     }
-    ~in_flight_guard() { flag = false; }
+    ~in_flight_guard() {
+      flag = false;
+      idle.notify();
+    }
   };
 
-  in_flight_guard guard{write_in_flight_};
+  in_flight_guard guard{write_in_flight_, io_idle_};
 
   auto tok = co_await iocoro::this_coro::stop_token;
   while (!tok.stop_requested() && state_ == connection_state::OPEN &&
@@ -113,6 +215,7 @@ inline auto connection::do_write() -> iocoro::awaitable<void> {
     REDISCORO_LOG_DEBUG("runtime write requested: bytes={}", view.size());
 
     auto r = co_await socket_.async_write_some(buf);
+    metrics_.write_ops.add();
     if (!r) {
       if (r.error() == iocoro::error::operation_aborted &&
           (state_ == connection_state::CLOSING || state_ == connection_state::CLOSED)) {
@@ -127,6 +230,9 @@ inline auto connection::do_write() -> iocoro::awaitable<void> {
 
     REDISCORO_LOG_DEBUG("runtime write completed: bytes={}", *r);
     pipeline_.on_write_done(*r);
+    REDISCORO_PROBE2(write__done, this, *r);
+    metrics_.bytes_written.add(*r);
+    update_queue_gauges();
     if (pipeline_.has_pending_read()) {
       read_wakeup_.notify();
     }
@@ -169,6 +275,7 @@ inline auto connection::handle_error(error_info ec) -> void {
     to_string(connection_state::OPEN), to_string(connection_state::FAILED), err.code.value(),
     err.code.message(), err.detail);
   set_state(connection_state::FAILED);
+  metrics_.disconnects.add();
   emit_connection_event(connection_event{
     .kind = connection_event_kind::disconnected,
     .stage = connection_event_stage::runtime_io,
@@ -176,7 +283,8 @@ inline auto connection::handle_error(error_info ec) -> void {
     .to_state = static_cast<std::int32_t>(connection_state::FAILED),
     .error = err,
   });
-  pipeline_.clear_all(err);
+  fail_pipeline(err);
+  dump_slow_requests();
   if (socket_.is_open()) {
     (void)socket_.close();
   }
@@ -185,4 +293,61 @@ inline auto connection::handle_error(error_info ec) -> void {
   read_wakeup_.notify();
 }
 
+inline auto connection::dump_slow_requests() -> void {
+  if (slow_log_ == nullptr || !cfg_.slow_requests.dump_on_disconnect) {
+    return;
+  }
+  // Records survive reconnects; only log those not already dumped by an earlier disconnect.
+  // Both calls run on the strand, the only writer, so the snapshot matches `total`.
+  auto const total = slow_log_->total();
+  auto const fresh = total - slow_log_dumped_;
+  slow_log_dumped_ = total;
+  if (fresh == 0) {
+    return;
+  }
+  auto const records = slow_log_->snapshot();
+  auto const skip = fresh < records.size() ? records.size() - static_cast<std::size_t>(fresh) : 0;
+  REDISCORO_LOG_WARNING(
+    "slow requests before disconnect: new={} recorded={} total={} generation={}",
+    records.size() - skip, records.size(), total, generation_);
+  auto const since = [](auto from, auto to) -> long long {
+    if (from == pipeline::time_point{} || to == pipeline::time_point{}) {
+      return -1;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+  };
+  for (auto const& r : std::span{records}.subspan(skip)) {
+    REDISCORO_LOG_WARNING(
+      "slow request: command={} commands={} request_bytes={} reply_bytes={} duration_us={} "
+      "queued_us={} write_us={} reply_us={} generation={} err_code={} err_msg={}",
+      r.command.view(), r.command_count, r.request_bytes, r.reply_bytes,
+      std::chrono::duration_cast<std::chrono::microseconds>(r.duration).count(),
+      since(r.enqueued, r.accepted), since(r.accepted, r.written), since(r.written, r.reply_read),
+      r.generation, r.error.value(), r.error ? r.error.message() : std::string{});
+  }
+}
+
+inline auto connection::expire_offline_requests() -> void {
+  auto const expired =
+    pipeline_.fail_expired_deferred(pipeline::clock::now(), client_errc::request_timeout);
+  if (expired > 0) {
+    REDISCORO_LOG_DEBUG("offline buffer expired requests: count={}", expired);
+    metrics_.timeouts.add(expired);
+    update_queue_gauges();
+  }
+}
+
+inline auto connection::fail_pipeline(error_info const& err) -> void {
+  if (!offline_buffering()) {
+    pipeline_.clear_all(err);
+    update_queue_gauges();
+    return;
+  }
+  auto const parked =
+    pipeline_.park(err, cfg_.offline_buffer.max_requests, cfg_.offline_buffer.max_bytes);
+  update_queue_gauges();
+  REDISCORO_LOG_INFO("offline buffer parked requests: count={} bytes={}", parked,
+                     pipeline_.deferred_bytes());
+}
+
 }  // namespace rediscoro::detail
@@ -60,9 +60,26 @@ inline auto connection::do_reconnect() -> iocoro::awaitable<void> {
     // This coroutine does not write FAILED redundantly; it only transitions:
     //   FAILED -> RECONNECTING -> (OPEN | FAILED)
     REDISCORO_ASSERT(state_ == connection_state::FAILED);
+    expire_offline_requests();
+
+    // Warm standby: fail over without delay, resolve, connect or handshake.
+    if (standby_ready_) {
+      co_await promote_standby();
+      if (state_ != connection_state::OPEN) {
+        REDISCORO_LOG_INFO("failover cancelled: state={}", to_string(state_));
+        co_return;
+      }
+      REDISCORO_LOG_INFO("failover to standby succeeded: generation={}", generation_);
+      read_wakeup_.notify();
+      write_wakeup_.notify();
+      control_wakeup_.notify();
+      co_return;
+    }
+
     const auto delay = calculate_reconnect_delay();
     REDISCORO_LOG_INFO("reconnect attempt: index={} delay_ms={} generation={}",
                        reconnect_count_ + 1, delay.count(), generation_);
+    REDISCORO_PROBE3(reconnect, this, reconnect_count_ + 1, delay.count());
 
     if (delay.count() > 0) {
       // NOTE: control_wakeup_ is a counting event. It may already have pending notifications
@@ -74,13 +91,16 @@ inline auto connection::do_reconnect() -> iocoro::awaitable<void> {
       const auto deadline = pipeline::clock::now() + delay;
       iocoro::steady_timer timer{executor_.get_io_executor()};
 
-      while (!tok.stop_requested() && state_ != connection_state::CLOSING) {
+      while (!tok.stop_requested() && state_ != connection_state::CLOSING && !standby_ready_) {
         const auto now = pipeline::clock::now();
         if (now >= deadline) {
           break;
         }
 
-        timer.expires_after(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now));
+        // Also wake for the earliest buffered request deadline (offline buffering).
+        expire_offline_requests();
+        const auto wake_at = std::min(deadline, pipeline_.next_deadline());
+        timer.expires_after(std::chrono::duration_cast<std::chrono::milliseconds>(wake_at - now));
 
         // Wait either for the timer or for an external control signal (close/notify).
         auto timer_wait = timer.async_wait(iocoro::use_awaitable);
@@ -94,6 +114,9 @@ inline auto connection::do_reconnect() -> iocoro::awaitable<void> {
       REDISCORO_LOG_INFO("reconnect cancelled: state={}", to_string(state_));
       co_return;
     }
+    if (standby_ready_) {
+      continue;  // A standby became ready during the backoff: promote it instead.
+    }
 
     // Attempt reconnect.
     REDISCORO_LOG_INFO("state transition: reason=reconnect_attempt from={} to={}",
@@ -126,4 +149,25 @@ inline auto connection::do_reconnect() -> iocoro::awaitable<void> {
   }
 }
 
+inline auto connection::promote_standby() -> iocoro::awaitable<void> {
+  REDISCORO_ASSERT(standby_ready_);
+  standby_ready_ = false;
+
+  // Never move a socket with an operation still pending: let the loops observe the failure of
+  // the old socket first.
+  while (read_in_flight_ || write_in_flight_) {
+    (void)co_await io_idle_.async_wait();
+  }
+  if (state_ != connection_state::FAILED) {
+    // Closed meanwhile: the standby is released by standby_loop().
+    co_return;
+  }
+
+  socket_ = std::move(standby_socket_);
+  standby_socket_ = iocoro::ip::tcp::socket{executor_.get_io_executor()};
+  parser_.reset();
+  parse_buffered_ = false;
+  enter_open(connection_event_stage::failover, "standby_promoted");
+}
+
 }  // namespace rediscoro::detail
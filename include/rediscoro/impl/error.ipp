@@ -44,6 +44,10 @@ class client_category_impl : public std::error_category {
         return "queue full";
       case client_errc::internal_error:
         return "internal error";
+      case client_errc::health_check_failed:
+        return "health check failed";
+      case client_errc::outcome_unknown:
+        return "outcome unknown (request may have executed)";
     }
     return "unknown client error";
   }
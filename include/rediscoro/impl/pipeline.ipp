@@ -2,31 +2,146 @@
 
 #include <rediscoro/detail/pipeline.hpp>
 
+#include <algorithm>
+
 namespace rediscoro::detail {
 
 inline auto pipeline::push(request req, std::shared_ptr<response_sink> sink) -> bool {
   return push(std::move(req), sink, time_point::max());
 }
 
-inline auto pipeline::push(request req, std::shared_ptr<response_sink> sink,
-                           time_point deadline) -> bool {
+inline auto pipeline::push(request req, std::shared_ptr<response_sink> sink, time_point deadline,
+                           bool replayable) -> bool {
   REDISCORO_ASSERT(sink != nullptr);
   REDISCORO_ASSERT(req.reply_count() == sink->expected_replies());
 
   const auto wire_bytes = req.wire().size();
-  if (pending_count() >= limits_.max_requests) {
+  if (!fits_limits(wire_bytes)) {
     return false;
   }
-  if (wire_bytes > limits_.max_pending_write_bytes ||
-      pending_write_bytes_ > (limits_.max_pending_write_bytes - wire_bytes)) {
+
+  pending_write_bytes_ += wire_bytes;
+  pending_write_.push_back(pending_item{std::move(req), std::move(sink), 0, deadline, replayable});
+  return true;
+}
+
+inline auto pipeline::push_internal(request req, std::shared_ptr<response_sink> sink) -> void {
+  REDISCORO_ASSERT(sink != nullptr);
+  REDISCORO_ASSERT(req.reply_count() == sink->expected_replies());
+
+  pending_write_bytes_ += req.wire().size();
+  pending_write_.push_back(pending_item{
+    .req = std::move(req),
+    .sink = std::move(sink),
+    .internal = true,
+  });
+}
+
+inline auto pipeline::defer(request req, std::shared_ptr<response_sink> sink, time_point deadline,
+                            bool replayable) -> bool {
+  REDISCORO_ASSERT(sink != nullptr);
+  REDISCORO_ASSERT(req.reply_count() == sink->expected_replies());
+
+  const auto wire_bytes = req.wire().size();
+  if (!fits_limits(wire_bytes)) {
     return false;
   }
 
   pending_write_bytes_ += wire_bytes;
-  pending_write_.push_back(pending_item{std::move(req), std::move(sink), 0, deadline});
+  deferred_bytes_ += wire_bytes;
+  deferred_.push_back(pending_item{std::move(req), std::move(sink), 0, deadline, replayable});
   return true;
 }
 
+inline auto pipeline::release_deferred() -> void {
+  while (!deferred_.empty()) {
+    pending_write_.push_back(std::move(deferred_.front()));
+    deferred_.pop_front();
+  }
+  deferred_bytes_ = 0;
+}
+
+inline auto pipeline::park(error_info const& err, std::size_t max_requests,
+                           std::size_t max_bytes) -> std::size_t {
+  ring_queue<pending_item> parked{};
+  std::size_t parked_bytes = 0;
+  auto keep = [&](pending_item item) -> void {
+    REDISCORO_ASSERT(item.sink != nullptr);
+    const auto bytes = item.req.wire().size();
+    if (item.internal || parked.size() >= max_requests || bytes > max_bytes ||
+        parked_bytes > max_bytes - bytes) {
+      item.sink->fail_all(err);
+      return;
+    }
+    item.written = 0;
+    parked_bytes += bytes;
+    parked.push_back(std::move(item));
+  };
+
+  // FIFO order: awaiting reads were submitted before pending writes, which precede deferred ones.
+  while (!awaiting_read_.empty()) {
+    auto& a = awaiting_read_.front();
+    REDISCORO_ASSERT(a.sink != nullptr);
+    if (a.replayable && !a.partial && !a.internal) {
+      keep(pending_item{std::move(a.req), std::move(a.sink), 0, a.deadline, true});
+    } else {
+      a.sink->fail_all(err);
+    }
+    awaiting_read_.pop_front();
+  }
+  for (auto* queue : {&pending_write_, &deferred_}) {
+    while (!queue->empty()) {
+      keep(std::move(queue->front()));
+      queue->pop_front();
+    }
+  }
+
+  deferred_ = std::move(parked);
+  deferred_bytes_ = parked_bytes;
+  pending_write_bytes_ = parked_bytes;
+  reset_write_batch();
+  return deferred_.size();
+}
+
+inline auto pipeline::fail_awaiting(error_info const& err) -> std::size_t {
+  std::size_t failed = 0;
+  while (!awaiting_read_.empty()) {
+    auto& a = awaiting_read_.front();
+    REDISCORO_ASSERT(a.sink != nullptr);
+    a.sink->fail_all(err);
+    awaiting_read_.pop_front();
+    failed += 1;
+  }
+  return failed;
+}
+
+inline auto pipeline::fail_expired_deferred(time_point now, error_info const& err)
+  -> std::size_t {
+  // The deferred queue is sorted by deadline: `connection::admit` never assigns a deadline
+  // earlier than `last_deadline()` (adaptive budgets are clamped to it; a fixed timeout is
+  // non-decreasing by construction), so only the front can be the next to expire.
+  std::size_t failed = 0;
+  while (!deferred_.empty() && deferred_.front().deadline <= now) {
+    auto& d = deferred_.front();
+    REDISCORO_ASSERT(d.sink != nullptr);
+    const auto bytes = d.req.wire().size();
+    pending_write_bytes_ -= bytes;
+    deferred_bytes_ -= bytes;
+    d.sink->fail_all(err);
+    deferred_.pop_front();
+    failed += 1;
+  }
+  return failed;
+}
+
+inline auto pipeline::fits_limits(std::size_t wire_bytes) const noexcept -> bool {
+  if (pending_count() >= limits_.max_requests) {
+    return false;
+  }
+  return wire_bytes <= limits_.max_pending_write_bytes &&
+         pending_write_bytes_ <= (limits_.max_pending_write_bytes - wire_bytes);
+}
+
 inline bool pipeline::has_pending_write() const noexcept {
   return !pending_write_.empty();
 }
@@ -37,53 +152,125 @@ inline bool pipeline::has_pending_read() const noexcept {
 
 inline auto pipeline::next_write_buffer() -> std::string_view {
   REDISCORO_ASSERT(!pending_write_.empty());
+  if (has_write_batch()) {
+    return std::string_view{write_batch_}.substr(write_batch_offset_);
+  }
+
   auto& front = pending_write_.front();
   const auto& wire = front.req.wire();
   REDISCORO_ASSERT(front.written <= wire.size());
-  return std::string_view{wire}.substr(front.written);
+
+  // Zero-copy path: a single request, or the front request is already partially written.
+  if (!write_options_.coalesce || front.written != 0 || pending_write_.size() < 2 ||
+      wire.size() >= write_options_.max_batch_bytes) {
+    return std::string_view{wire}.substr(front.written);
+  }
+
+  // Coalesce consecutive requests into one buffer (bounded by bytes and request count).
+  reset_write_batch();
+  const auto max_requests = write_options_.max_batch_requests;
+  std::size_t batched = 0;
+  while (batched < pending_write_.size() && batched < max_requests) {
+    const auto& next = pending_write_.at(batched).req.wire();
+    if (batched > 0 && write_batch_.size() + next.size() > write_options_.max_batch_bytes) {
+      break;
+    }
+    write_batch_.append(next);
+    batched += 1;
+  }
+
+  if (batched < 2) {
+    reset_write_batch();
+    return std::string_view{wire};
+  }
+  return std::string_view{write_batch_};
 }
 
 inline auto pipeline::on_write_done(std::size_t n) -> void {
   REDISCORO_ASSERT(!pending_write_.empty());
-  auto& front = pending_write_.front();
-  const auto& wire = front.req.wire();
-  REDISCORO_ASSERT(front.written <= wire.size());
-  REDISCORO_ASSERT(n <= (wire.size() - front.written));
   REDISCORO_ASSERT(n <= pending_write_bytes_);
 
-  front.written += n;
+  if (has_write_batch()) {
+    REDISCORO_ASSERT(n <= (write_batch_.size() - write_batch_offset_));
+    write_batch_offset_ += n;
+    if (write_batch_offset_ == write_batch_.size()) {
+      reset_write_batch();
+    }
+  } else {
+    REDISCORO_ASSERT(n <= (pending_write_.front().req.wire().size() -
+                           pending_write_.front().written));
+  }
+
   pending_write_bytes_ -= n;
 
-  if (front.written == wire.size()) {
+  // Distribute written bytes across requests in FIFO order (a coalesced write may complete
+  // several requests at once and end in the middle of another).
+  auto const now = stamp_phases_ ? clock::now() : time_point{};
+  while (!pending_write_.empty()) {
+    auto& front = pending_write_.front();
+    const auto& wire = front.req.wire();
+    REDISCORO_ASSERT(front.written <= wire.size());
+
+    const auto take = std::min(n, wire.size() - front.written);
+    front.written += take;
+    n -= take;
+
+    if (front.written != wire.size()) {
+      break;
+    }
+
     // Entire request written: move to awaiting read queue.
-    awaiting_read_.push_back(awaiting_item{std::move(front.sink), front.deadline});
+    if (stamp_phases_) {
+      front.sink->stamp_written(now);
+    }
+    awaiting_read_.push_back(awaiting_item{
+      .sink = std::move(front.sink),
+      .deadline = front.deadline,
+      .req = front.replayable ? std::move(front.req) : request{},
+      .replayable = front.replayable,
+      .internal = front.internal,
+    });
     pending_write_.pop_front();
   }
+  REDISCORO_ASSERT(n == 0);
 }
 
 inline auto pipeline::on_message(resp3::message msg) -> void {
   REDISCORO_ASSERT(!awaiting_read_.empty());
-  auto& sink = awaiting_read_.front().sink;
-  REDISCORO_ASSERT(sink != nullptr);
+  auto& front = awaiting_read_.front();
+  REDISCORO_ASSERT(front.sink != nullptr);
 
-  sink->deliver(std::move(msg));
-  if (sink->is_complete()) {
+  front.sink->deliver(std::move(msg));
+  if (front.sink->is_complete()) {
     awaiting_read_.pop_front();
+  } else {
+    front.partial = true;
   }
 }
 
 inline auto pipeline::on_error(error_info err) -> void {
   REDISCORO_ASSERT(!awaiting_read_.empty());
-  auto& sink = awaiting_read_.front().sink;
-  REDISCORO_ASSERT(sink != nullptr);
+  auto& front = awaiting_read_.front();
+  REDISCORO_ASSERT(front.sink != nullptr);
 
-  sink->deliver_error(std::move(err));
-  if (sink->is_complete()) {
+  front.sink->deliver_error(std::move(err));
+  if (front.sink->is_complete()) {
     awaiting_read_.pop_front();
+  } else {
+    front.partial = true;
   }
 }
 
 inline auto pipeline::clear_all(error_info err) -> void {
+  // Deferred requests were never written; fail them like pending writes.
+  while (!deferred_.empty()) {
+    auto& d = deferred_.front();
+    REDISCORO_ASSERT(d.sink != nullptr);
+    d.sink->fail_all(err);
+    deferred_.pop_front();
+  }
+  deferred_bytes_ = 0;
+
   // Pending writes: none of the replies will arrive; fail all expected replies.
   while (!pending_write_.empty()) {
     auto& p = pending_write_.front();
@@ -92,6 +279,7 @@ inline auto pipeline::clear_all(error_info err) -> void {
     pending_write_.pop_front();
   }
   pending_write_bytes_ = 0;
+  reset_write_batch();
 
   // Awaiting reads: fail all remaining replies.
   while (!awaiting_read_.empty()) {
@@ -105,13 +293,36 @@ inline auto pipeline::clear_all(error_info err) -> void {
 inline auto pipeline::next_deadline() const noexcept -> time_point {
   time_point a = time_point::max();
   time_point b = time_point::max();
+  time_point c = time_point::max();
   if (!pending_write_.empty()) {
     a = pending_write_.front().deadline;
   }
   if (!awaiting_read_.empty()) {
     b = awaiting_read_.front().deadline;
   }
-  return std::min(a, b);
+  if (!deferred_.empty()) {
+    c = deferred_.front().deadline;
+  }
+  return std::min({a, b, c});
+}
+
+inline auto pipeline::last_deadline() const noexcept -> time_point {
+  time_point latest = time_point::min();
+  auto consider = [&latest](time_point d) {
+    if (d != time_point::max()) {
+      latest = std::max(latest, d);
+    }
+  };
+  if (!deferred_.empty()) {
+    consider(deferred_.at(deferred_.size() - 1).deadline);
+  }
+  if (!pending_write_.empty()) {
+    consider(pending_write_.at(pending_write_.size() - 1).deadline);
+  }
+  if (!awaiting_read_.empty()) {
+    consider(awaiting_read_.at(awaiting_read_.size() - 1).deadline);
+  }
+  return latest;
 }
 
 inline bool pipeline::has_expired() const noexcept {
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <rediscoro/detail/command_info.hpp>
+#include <rediscoro/tracing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rediscoro {
+
+/// Tuning of a `key_tracker`.
+struct key_tracker_options {
+  // Track one request in `sample_every` per connection (0 and 1 track every request).
+  std::uint32_t sample_every = 1;
+
+  // Entries kept in the hot-key and big-key tables.
+  std::size_t top_k = 16;
+
+  // Counters per count-min sketch row (rounded up to a power of two); memory is
+  // 4 * sketch_width * 4 bytes.
+  std::size_t sketch_width = 4096;
+
+  // Keys are truncated to this many bytes in reports (the sketch always hashes the whole key).
+  std::size_t max_key_bytes = 128;
+};
+
+/// A frequently accessed key.
+struct hot_key {
+  std::string key{};
+  // Estimated accesses (count-min upper bound, scaled by `sample_every`).
+  std::uint64_t estimated_count{0};
+};
+
+/// A key whose reply was among the largest seen.
+struct big_key {
+  std::string key{};
+  std::string command{};
+  std::size_t reply_bytes{0};  // largest reply seen for this key
+};
+
+/// Reply sizes of one command verb (sampled requests only).
+struct command_reply_stats {
+  std::string command{};
+  std::uint64_t sampled{0};
+  std::uint64_t reply_bytes{0};  // total over `sampled` requests
+  std::uint64_t max_reply_bytes{0};
+};
+
+struct key_tracker_snapshot {
+  std::vector<hot_key> hot_keys{};              // most accessed first
+  std::vector<big_key> big_keys{};              // largest reply first
+  std::vector<command_reply_stats> commands{};  // most reply bytes first
+  std::uint64_t sampled{0};                     // requests recorded
+};
+
+/// Client-side hot-key and big-key detection.
+///
+/// Every sampled request is attributed to the verb and first key of its first command (like
+/// `latency_recorder`), together with the total size of its RESP3 replies on the wire:
+/// - key frequencies go into a count-min sketch; keys whose estimate beats the current top-K
+///   minimum enter the hot-key table;
+/// - replies larger than the smallest tracked big key enter the big-key table;
+/// - per-verb reply sizes are aggregated (count, total, max).
+///
+/// Configure through `config::key_tracking`, possibly shared between clients, and read it with
+/// `snapshot()`.
+///
+/// Thread-safety: `record()` and `snapshot()` may run concurrently from any thread. The sketch
+/// and per-verb counters are lock-free; the top-K tables take a mutex only when a key qualifies
+/// for them.
+class key_tracker {
+ public:
+  static constexpr std::size_t sketch_depth = 4;
+  static constexpr std::size_t max_commands = 64;
+  static constexpr std::size_t max_command_name = 24;
+
+  key_tracker() : key_tracker(key_tracker_options{}) {}
+
+  explicit key_tracker(key_tracker_options opts)
+      : opts_(opts),
+        width_(std::bit_ceil(std::max<std::size_t>(opts.sketch_width, 64))),
+        sketch_(std::make_unique<std::atomic<std::uint32_t>[]>(sketch_depth * width_)) {
+    if (opts_.top_k == 0) {
+      opts_.top_k = 1;
+    }
+  }
+
+  key_tracker(key_tracker const&) = delete;
+  auto operator=(key_tracker const&) -> key_tracker& = delete;
+
+  [[nodiscard]] auto options() const noexcept -> key_tracker_options const& { return opts_; }
+
+  /// Record one sampled request: verb and first key of its first command (key may be empty) and
+  /// the total wire size of its replies.
+  auto record(std::string_view command, std::string_view key, std::size_t reply_bytes) -> void {
+    sampled_.fetch_add(1, std::memory_order_relaxed);
+    record_command(command, reply_bytes);
+    if (key.empty()) {
+      return;
+    }
+
+    auto const estimate = sketch_add(key);
+    bool const hot = estimate >= hot_threshold_.load(std::memory_order_relaxed);
+    bool const big = reply_bytes > big_threshold_.load(std::memory_order_relaxed);
+    if (!hot && !big) {
+      return;
+    }
+    auto const shown = key.substr(0, opts_.max_key_bytes);
+    std::lock_guard lock(mu_);
+    if (hot) {
+      update_hot(shown, estimate);
+    }
+    if (big) {
+      update_big(shown, command, reply_bytes);
+    }
+  }
+
+  /// Estimated number of sampled accesses of `key` (never an underestimate).
+  [[nodiscard]] auto estimate(std::string_view key) const noexcept -> std::uint64_t {
+    auto const h = hash(key);
+    auto best = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t row = 0; row < sketch_depth; ++row) {
+      best = std::min<std::uint64_t>(best, cell(h, row).load(std::memory_order_relaxed));
+    }
+    return best;
+  }
+
+  [[nodiscard]] auto snapshot() const -> key_tracker_snapshot {
+    key_tracker_snapshot out{};
+    out.sampled = sampled_.load(std::memory_order_relaxed);
+    auto const scale = std::max<std::uint64_t>(opts_.sample_every, 1);
+    {
+      std::lock_guard lock(mu_);
+      out.hot_keys.reserve(hot_.size());
+      for (auto const& e : hot_) {
+        out.hot_keys.push_back(hot_key{.key = e.key, .estimated_count = e.count * scale});
+      }
+      out.big_keys = big_;
+    }
+    std::ranges::sort(out.hot_keys, std::ranges::greater{}, &hot_key::estimated_count);
+    std::ranges::sort(out.big_keys, std::ranges::greater{}, &big_key::reply_bytes);
+
+    for (auto const& s : commands_) {
+      if (!s.ready.load(std::memory_order_acquire)) {
+        continue;
+      }
+      out.commands.push_back(command_reply_stats{
+        .command = std::string{s.name.data(), s.size},
+        .sampled = s.count.load(std::memory_order_relaxed),
+        .reply_bytes = s.bytes.load(std::memory_order_relaxed),
+        .max_reply_bytes = s.max_bytes.load(std::memory_order_relaxed),
+      });
+    }
+    std::ranges::sort(out.commands, std::ranges::greater{}, &command_reply_stats::reply_bytes);
+    return out;
+  }
+
+  /// Forget everything recorded so far (command slots stay allocated).
+  auto reset() -> void {
+    for (std::size_t i = 0; i < sketch_depth * width_; ++i) {
+      sketch_[i].store(0, std::memory_order_relaxed);
+    }
+    for (auto& s : commands_) {
+      s.count.store(0, std::memory_order_relaxed);
+      s.bytes.store(0, std::memory_order_relaxed);
+      s.max_bytes.store(0, std::memory_order_relaxed);
+    }
+    sampled_.store(0, std::memory_order_relaxed);
+    std::lock_guard lock(mu_);
+    hot_.clear();
+    big_.clear();
+    hot_threshold_.store(0, std::memory_order_relaxed);
+    big_threshold_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  struct hot_entry {
+    std::string key{};
+    std::uint64_t count{0};
+  };
+
+  struct command_slot {
+    std::atomic<bool> ready{false};
+    std::array<char, max_command_name> name{};  // written once, before `ready` is published
+    std::size_t size{0};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> max_bytes{0};
+  };
+
+  // Same hash as `request_trace_info::key_hash`.
+  static auto hash(std::string_view s) noexcept -> std::uint64_t { return trace_key_hash(s); }
+
+  // Row `row` indexes with h1 + row * h2 (double hashing).
+  [[nodiscard]] auto cell(std::uint64_t h, std::size_t row) const noexcept
+    -> std::atomic<std::uint32_t>& {
+    auto const h1 = static_cast<std::uint32_t>(h);
+    auto const h2 = static_cast<std::uint32_t>(h >> 32) | 1U;
+    auto const col = (h1 + static_cast<std::uint32_t>(row) * h2) & (width_ - 1);
+    return sketch_[row * width_ + col];
+  }
+
+  auto sketch_add(std::string_view key) noexcept -> std::uint64_t {
+    auto const h = hash(key);
+    auto best = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t row = 0; row < sketch_depth; ++row) {
+      auto const v = cell(h, row).fetch_add(1, std::memory_order_relaxed) + 1;
+      best = std::min<std::uint64_t>(best, v);
+    }
+    return best;
+  }
+
+  // Requires mu_.
+  auto update_hot(std::string_view key, std::uint64_t estimate) -> void {
+    auto it = std::ranges::find(hot_, key, &hot_entry::key);
+    if (it != hot_.end()) {
+      it->count = std::max(it->count, estimate);
+    } else if (hot_.size() < opts_.top_k) {
+      hot_.push_back(hot_entry{.key = std::string{key}, .count = estimate});
+    } else {
+      auto min = std::ranges::min_element(hot_, {}, &hot_entry::count);
+      if (estimate <= min->count) {
+        return;
+      }
+      *min = hot_entry{.key = std::string{key}, .count = estimate};
+    }
+    if (hot_.size() == opts_.top_k) {
+      hot_threshold_.store(std::ranges::min(hot_, {}, &hot_entry::count).count,
+                           std::memory_order_relaxed);
+    }
+  }
+
+  // Requires mu_.
+  auto update_big(std::string_view key, std::string_view command, std::size_t bytes) -> void {
+    auto it = std::ranges::find(big_, key, &big_key::key);
+    if (it != big_.end()) {
+      if (bytes > it->reply_bytes) {
+        it->reply_bytes = bytes;
+        it->command = std::string{command};
+      }
+    } else if (big_.size() < opts_.top_k) {
+      big_.push_back(big_key{.key = std::string{key}, .command = std::string{command},
+                             .reply_bytes = bytes});
+    } else {
+      auto min = std::ranges::min_element(big_, {}, &big_key::reply_bytes);
+      if (bytes <= min->reply_bytes) {
+        return;
+      }
+      *min = big_key{.key = std::string{key}, .command = std::string{command},
+                     .reply_bytes = bytes};
+    }
+    if (big_.size() == opts_.top_k) {
+      big_threshold_.store(std::ranges::min(big_, {}, &big_key::reply_bytes).reply_bytes,
+                           std::memory_order_relaxed);
+    }
+  }
+
+  auto record_command(std::string_view verb, std::size_t bytes) -> void {
+    auto* s = command_slot_for(verb);
+    if (s == nullptr) {
+      return;
+    }
+    s->count.fetch_add(1, std::memory_order_relaxed);
+    s->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    auto seen = s->max_bytes.load(std::memory_order_relaxed);
+    while (bytes > seen &&
+           !s->max_bytes.compare_exchange_weak(seen, bytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Slot of `verb` (ASCII case-insensitive), created on first use; nullptr once the table is
+  // full or for names longer than `max_command_name`.
+  auto command_slot_for(std::string_view verb) -> command_slot* {
+    if (verb.empty() || verb.size() > max_command_name) {
+      return nullptr;
+    }
+    std::array<char, max_command_name> upper{};
+    for (std::size_t i = 0; i < verb.size(); ++i) {
+      upper[i] = detail::ascii_upper(verb[i]);
+    }
+    std::string_view const name{upper.data(), verb.size()};
+    auto const start = static_cast<std::size_t>(hash(name) % max_commands);
+    if (auto* s = find_command(name, start); s != nullptr) {
+      return s;
+    }
+
+    std::lock_guard lock(command_mu_);
+    for (std::size_t i = 0; i < max_commands; ++i) {
+      auto& s = commands_[(start + i) % max_commands];
+      if (!s.ready.load(std::memory_order_acquire)) {
+        s.name = upper;
+        s.size = verb.size();
+        s.ready.store(true, std::memory_order_release);
+        return &s;
+      }
+      if (std::string_view{s.name.data(), s.size} == name) {
+        return &s;
+      }
+    }
+    return nullptr;
+  }
+
+  // Lock-free probe for an upper-cased verb.
+  auto find_command(std::string_view name, std::size_t start) noexcept -> command_slot* {
+    for (std::size_t i = 0; i < max_commands; ++i) {
+      auto& s = commands_[(start + i) % max_commands];
+      if (!s.ready.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+      if (std::string_view{s.name.data(), s.size} == name) {
+        return &s;
+      }
+    }
+    return nullptr;
+  }
+
+  key_tracker_options opts_;
+  std::size_t width_;
+  std::unique_ptr<std::atomic<std::uint32_t>[]> sketch_;
+  std::atomic<std::uint64_t> sampled_{0};
+
+  // Admission thresholds for the top-K tables (0 until a table is full).
+  std::atomic<std::uint64_t> hot_threshold_{0};
+  std::atomic<std::uint64_t> big_threshold_{0};
+
+  mutable std::mutex mu_{};
+  std::vector<hot_entry> hot_{};
+  std::vector<big_key> big_{};
+
+  std::array<command_slot, max_commands> commands_{};
+  std::mutex command_mu_{};
+};
+
+}  // namespace rediscoro
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <rediscoro/detail/command_info.hpp>
+#include <rediscoro/detail/fnv1a.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace rediscoro {
+
+/// Percentiles exported from a `latency_histogram`.
+struct latency_summary {
+  std::uint64_t count{0};
+  std::chrono::nanoseconds p50{};
+  std::chrono::nanoseconds p90{};
+  std::chrono::nanoseconds p99{};
+  std::chrono::nanoseconds p999{};
+  std::chrono::nanoseconds max{};
+};
+
+/// Log-linear (HDR-style) latency histogram with constant memory.
+///
+/// Each power-of-two range is split into `1 << (sub_bucket_bits - 1)` linear buckets, so a
+/// reported percentile is at most ~3% above the recorded value. Values up to ~68.7 s are
+/// resolved; longer ones land in the top bucket (`max` stays exact).
+///
+/// Thread-safety: `record()` and the readers may run concurrently from any thread (relaxed
+/// atomics). A reader racing with writers sees a slightly stale but consistent-enough view.
+class latency_histogram {
+ public:
+  static constexpr unsigned sub_bucket_bits = 6;
+  static constexpr unsigned max_value_bits = 36;
+  static constexpr std::size_t bucket_count =
+    ((max_value_bits - sub_bucket_bits) << (sub_bucket_bits - 1)) +
+    (std::size_t{1} << sub_bucket_bits);
+
+  latency_histogram() = default;
+  latency_histogram(latency_histogram const&) = delete;
+  auto operator=(latency_histogram const&) -> latency_histogram& = delete;
+
+  auto record(std::chrono::nanoseconds d) noexcept -> void {
+    record_value(d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0U);
+  }
+
+  auto record_value(std::uint64_t ns) noexcept -> void {
+    counts_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(1, std::memory_order_relaxed);
+    auto seen = max_.load(std::memory_order_relaxed);
+    while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Add every sample of `other` (e.g. aggregate connections).
+  auto merge(latency_histogram const& other) noexcept -> void {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      if (auto const n = other.counts_[i].load(std::memory_order_relaxed); n != 0) {
+        counts_[i].fetch_add(n, std::memory_order_relaxed);
+      }
+    }
+    total_.fetch_add(other.count(), std::memory_order_relaxed);
+    auto const m = other.max_.load(std::memory_order_relaxed);
+    auto seen = max_.load(std::memory_order_relaxed);
+    while (m > seen && !max_.compare_exchange_weak(seen, m, std::memory_order_relaxed)) {
+    }
+  }
+
+  auto reset() noexcept -> void {
+    for (auto& c : counts_) {
+      c.store(0, std::memory_order_relaxed);
+    }
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto count() const noexcept -> std::uint64_t {
+    return total_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto max() const noexcept -> std::chrono::nanoseconds {
+    auto const v = max_.load(std::memory_order_relaxed);
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(v)};
+  }
+
+  /// Smallest recorded latency such that `percentile` percent of samples are at or below it
+  /// (bucket upper bound, capped at `max()`). Zero when empty.
+  [[nodiscard]] auto value_at_percentile(double percentile) const noexcept
+    -> std::chrono::nanoseconds {
+    std::uint64_t total = 0;
+    for (auto const& c : counts_) {
+      total += c.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+      return std::chrono::nanoseconds{0};
+    }
+    auto const p = std::clamp(percentile, 0.0, 100.0);
+    auto target = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+    target = std::clamp<std::uint64_t>(target, 1, total);
+
+    auto const cap = max_.load(std::memory_order_relaxed);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        return std::chrono::nanoseconds{static_cast<std::int64_t>(std::min(bucket_upper(i), cap))};
+      }
+    }
+    return max();
+  }
+
+  [[nodiscard]] auto summary() const noexcept -> latency_summary {
+    return latency_summary{
+      .count = count(),
+      .p50 = value_at_percentile(50.0),
+      .p90 = value_at_percentile(90.0),
+      .p99 = value_at_percentile(99.0),
+      .p999 = value_at_percentile(99.9),
+      .max = max(),
+    };
+  }
+
+  /// Bucket of a value; exposed for tests.
+  [[nodiscard]] static constexpr auto bucket_index(std::uint64_t v) noexcept -> std::size_t {
+    constexpr std::uint64_t top = (std::uint64_t{1} << max_value_bits) - 1;
+    v = std::min(v, top);
+    if (v < (std::uint64_t{1} << sub_bucket_bits)) {
+      return static_cast<std::size_t>(v);
+    }
+    auto const shift = static_cast<unsigned>(std::bit_width(v)) - sub_bucket_bits;
+    return (static_cast<std::size_t>(shift) << (sub_bucket_bits - 1)) +
+           static_cast<std::size_t>(v >> shift);
+  }
+
+  /// Largest value mapped to bucket `i`.
+  [[nodiscard]] static constexpr auto bucket_upper(std::size_t i) noexcept -> std::uint64_t {
+    constexpr std::size_t half = std::size_t{1} << (sub_bucket_bits - 1);
+    if (i < 2 * half) {
+      return i;
+    }
+    auto const shift = i / half - 1;
+    auto const mantissa = static_cast<std::uint64_t>(i % half + half);
+    return ((mantissa + 1) << shift) - 1;
+  }
+
+ private:
+  std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};
+  std::atomic<std::uint64_t> total_{0};
+  std::atomic<std::uint64_t> max_{0};
+};
+
+/// Built-in request latency recorder (see `config::latency`).
+///
+/// Aggregates the end-to-end latency of every completed request (the duration reported by
+/// `request_trace_finish`) into one overall histogram and one histogram per command verb.
+/// Requests are attributed to the verb of their first command; verbs beyond `max_commands`
+/// distinct names (or longer than `max_command_name`) are counted under `other()`.
+///
+/// Share one recorder between clients to aggregate them, or give each client its own and
+/// `merge()` them when exporting.
+///
+/// Thread-safety: recording and reading may run concurrently from any thread. A per-command
+/// histogram is allocated (under a mutex) the first time its verb is seen; lookups are
+/// lock-free.
+class latency_recorder {
+ public:
+  static constexpr std::size_t max_commands = 64;
+  static constexpr std::size_t max_command_name = 24;
+
+  /// Histograms a single request is recorded into.
+  struct target {
+    latency_histogram* overall{nullptr};
+    latency_histogram* command{nullptr};
+  };
+
+  latency_recorder() = default;
+  latency_recorder(latency_recorder const&) = delete;
+  auto operator=(latency_recorder const&) -> latency_recorder& = delete;
+
+  auto record(std::string_view verb, std::chrono::nanoseconds d) -> void {
+    overall_.record(d);
+    command(verb).record(d);
+  }
+
+  [[nodiscard]] auto overall() const noexcept -> latency_histogram const& { return overall_; }
+  [[nodiscard]] auto other() const noexcept -> latency_histogram const& { return other_; }
+
+  /// Histogram of `verb` (ASCII case-insensitive), or nullptr when it was never recorded.
+  [[nodiscard]] auto find(std::string_view verb) const noexcept -> latency_histogram const* {
+    name_buffer upper{};
+    if (!normalize(verb, upper)) {
+      return nullptr;
+    }
+    return lookup(upper.view());
+  }
+
+  /// Histogram of `verb`, created on first use (`other()` once the table is full).
+  auto command(std::string_view verb) -> latency_histogram& {
+    name_buffer upper{};
+    if (!normalize(verb, upper)) {
+      return other_;
+    }
+    if (auto* h = lookup(upper.view()); h != nullptr) {
+      return *h;
+    }
+
+    std::lock_guard lock(mu_);
+    auto const name = upper.view();
+    auto const start = hash(name);
+    for (std::size_t i = 0; i < max_commands; ++i) {
+      auto& s = slots_[(start + i) % max_commands];
+      auto* h = s.hist.load(std::memory_order_acquire);
+      if (h == nullptr) {
+        owned_.push_back(std::make_unique<latency_histogram>());
+        s.name = upper;
+        s.hist.store(owned_.back().get(), std::memory_order_release);
+        return *owned_.back();
+      }
+      if (s.name.view() == name) {
+        return *h;
+      }
+    }
+    return other_;
+  }
+
+  /// Targets for a request with the given encoded wire bytes (`request::wire()`).
+  auto target_for(std::string_view wire) -> target {
+    return target{.overall = &overall_, .command = &command(detail::first_command_verb(wire))};
+  }
+
+  /// Call `fn(verb, histogram)` for every command seen so far.
+  template <typename F>
+  auto for_each_command(F&& fn) const -> void {
+    for (auto const& s : slots_) {
+      if (auto const* h = s.hist.load(std::memory_order_acquire); h != nullptr) {
+        fn(s.name.view(), *h);
+      }
+    }
+  }
+
+  /// Add every sample recorded by `other`.
+  auto merge(latency_recorder const& other) -> void {
+    overall_.merge(other.overall_);
+    other_.merge(other.other_);
+    other.for_each_command([this](std::string_view verb, latency_histogram const& h) {
+      command(verb).merge(h);
+    });
+  }
+
+  /// Clear all samples (command slots stay allocated).
+  auto reset() noexcept -> void {
+    overall_.reset();
+    other_.reset();
+    for (auto& s : slots_) {
+      if (auto* h = s.hist.load(std::memory_order_acquire); h != nullptr) {
+        h->reset();
+      }
+    }
+  }
+
+ private:
+  struct name_buffer {
+    std::array<char, max_command_name> data{};
+    std::size_t size{0};
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view { return {data.data(), size}; }
+  };
+
+  struct slot {
+    std::atomic<latency_histogram*> hist{nullptr};
+    name_buffer name{};  // written once, before `hist` is published
+  };
+
+  // Lock-free probe for an upper-cased verb.
+  [[nodiscard]] auto lookup(std::string_view name) const noexcept -> latency_histogram* {
+    auto const start = hash(name);
+    for (std::size_t i = 0; i < max_commands; ++i) {
+      auto const& s = slots_[(start + i) % max_commands];
+      auto* h = s.hist.load(std::memory_order_acquire);
+      if (h == nullptr) {
+        return nullptr;
+      }
+      if (s.name.view() == name) {
+        return h;
+      }
+    }
+    return nullptr;
+  }
+
+  static auto normalize(std::string_view verb, name_buffer& out) noexcept -> bool {
+    if (verb.empty() || verb.size() > max_command_name) {
+      return false;
+    }
+    for (std::size_t i = 0; i < verb.size(); ++i) {
+      out.data[i] = detail::ascii_upper(verb[i]);
+    }
+    out.size = verb.size();
+    return true;
+  }
+
+  static auto hash(std::string_view name) noexcept -> std::size_t {
+    return static_cast<std::size_t>(detail::fnv1a_64(name) % max_commands);
+  }
+
+  latency_histogram overall_{};
+  latency_histogram other_{};
+  std::array<slot, max_commands> slots_{};
+
+  std::mutex mu_{};
+  std::vector<std::unique_ptr<latency_histogram>> owned_{};
+};
+
+}  // namespace rediscoro
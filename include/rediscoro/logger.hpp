@@ -6,6 +6,13 @@
 #include <string>
 #include <string_view>
 
+// Compile-time minimum log level: 0 = debug (default), 1 = info, 2 = warning, 3 = error,
+// 4 = off. Call sites below it compile to nothing (their arguments are never evaluated), and
+// `logger` drops such records at runtime as well.
+#ifndef REDISCORO_LOG_MIN_LEVEL
+#define REDISCORO_LOG_MIN_LEVEL 0
+#endif
+
 #if defined(__cpp_lib_format) && __has_include(<format>)
 #include <format>
 namespace rediscoro {
@@ -44,6 +51,10 @@ constexpr auto to_string(log_level level) noexcept -> char const* {
   }
 }
 
+/// Compile-time floor below which nothing is logged (see `REDISCORO_LOG_MIN_LEVEL`).
+inline constexpr log_level compile_time_min_log_level = static_cast<log_level>(
+  REDISCORO_LOG_MIN_LEVEL < 0 ? 0 : (REDISCORO_LOG_MIN_LEVEL > 4 ? 4 : REDISCORO_LOG_MIN_LEVEL));
+
 struct log_context {
   log_level level;
   std::string_view message;
@@ -54,6 +65,41 @@ struct log_context {
 
 using log_function = void (*)(void*, log_context const&);
 
+/// Format a record the way the default log function prints it (without trailing newline).
+inline auto format_log_line(log_context const& ctx) -> std::string {
+  auto time = std::chrono::system_clock::to_time_t(ctx.timestamp);
+  std::tm tm{};
+  localtime_r(&time, &tm);
+  auto ms =
+    std::chrono::duration_cast<std::chrono::milliseconds>(ctx.timestamp.time_since_epoch()) % 1000;
+
+  // Extract filename from path
+  auto file = [&]() -> std::string_view {
+    auto path = ctx.file;
+
+    // Prefer showing the path relative to the `rediscoro/` directory (excluding `rediscoro` itself).
+    constexpr std::string_view k_rediscoro_posix = "rediscoro/";
+    constexpr std::string_view k_rediscoro_win = "rediscoro\\";
+    if (auto pos = path.find(k_rediscoro_posix); pos != std::string_view::npos) {
+      return path.substr(pos + k_rediscoro_posix.size());
+    }
+    if (auto pos = path.find(k_rediscoro_win); pos != std::string_view::npos) {
+      return path.substr(pos + k_rediscoro_win.size());
+    }
+
+    // Fallback: basename only.
+    if (auto pos = path.find_last_of("/\\"); pos != std::string_view::npos) {
+      return path.substr(pos + 1);
+    }
+    return path;
+  }();
+
+  return format_impl::format(
+    "[{:04d}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}.{:03d}] [rediscoro] [{}] [{}:{}] {}",
+    tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, ms.count(),
+    to_string(ctx.level), file, ctx.line, ctx.message);
+}
+
 class logger {
  public:
   static auto instance() -> logger& {
@@ -73,12 +119,16 @@ class logger {
     log_user_data_ = nullptr;
   }
 
+  auto get_log_function() const -> log_function { return log_fn_; }
+
+  auto get_log_user_data() const -> void* { return log_user_data_; }
+
   void set_log_level(log_level level) { min_level_.store(level, std::memory_order_relaxed); }
 
   auto get_log_level() const -> log_level { return min_level_.load(std::memory_order_relaxed); }
 
   void log(log_level level, std::string_view message, std::string_view file, int line) {
-    if (level < min_level_.load(std::memory_order_relaxed)) {
+    if (level < compile_time_min_log_level || level < min_level_.load(std::memory_order_relaxed)) {
       return;
     }
 
@@ -95,7 +145,7 @@ class logger {
   template <typename... Args>
   void log(log_level level, std::string_view file, int line,
            format_impl::format_string<Args...> fmt, Args&&... args) {
-    if (level < min_level_.load(std::memory_order_relaxed)) {
+    if (level < compile_time_min_log_level || level < min_level_.load(std::memory_order_relaxed)) {
       return;
     }
 
@@ -108,40 +158,8 @@ class logger {
   logger() : log_fn_(&default_log_function), log_user_data_(nullptr), min_level_(log_level::off) {}
 
   static void default_log_function(void*, log_context const& ctx) {
-    auto time = std::chrono::system_clock::to_time_t(ctx.timestamp);
-    std::tm tm{};
-    localtime_r(&time, &tm);
-    auto ms =
-      std::chrono::duration_cast<std::chrono::milliseconds>(ctx.timestamp.time_since_epoch()) %
-      1000;
-
-    // Extract filename from path
-    auto file = [&]() -> std::string_view {
-      auto path = ctx.file;
-
-      // Prefer showing the path relative to the `rediscoro/` directory (excluding `rediscoro` itself).
-      constexpr std::string_view k_rediscoro_posix = "rediscoro/";
-      constexpr std::string_view k_rediscoro_win = "rediscoro\\";
-      if (auto pos = path.find(k_rediscoro_posix); pos != std::string_view::npos) {
-        return path.substr(pos + k_rediscoro_posix.size());
-      }
-      if (auto pos = path.find(k_rediscoro_win); pos != std::string_view::npos) {
-        return path.substr(pos + k_rediscoro_win.size());
-      }
-
-      // Fallback: basename only.
-      if (auto pos = path.find_last_of("/\\"); pos != std::string_view::npos) {
-        return path.substr(pos + 1);
-      }
-      return path;
-    }();
-
-    auto formatted = format_impl::format(
-      "[{:04d}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}.{:03d}] [rediscoro] [{}] [{}:{}] {}",
-      tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, ms.count(),
-      to_string(ctx.level), file, ctx.line, ctx.message);
-
-    std::cerr << formatted << std::endl;
+    // std::cerr is unit-buffered: '\n' instead of std::endl avoids a second flush.
+    std::cerr << format_log_line(ctx) << '\n';
   }
 
   log_function log_fn_;
@@ -164,18 +182,47 @@ inline void set_log_level(log_level level) {
 
 }  // namespace rediscoro
 
+// Stripped call sites stay type-checked (no unused-variable warnings) but are never executed.
+#define REDISCORO_LOG_DISCARD_(level, fmt, ...)                                    \
+  do {                                                                             \
+    if (false) {                                                                   \
+      ::rediscoro::get_logger().log(level, __FILE__, __LINE__,                     \
+                                    fmt __VA_OPT__(, ) __VA_ARGS__);               \
+    }                                                                              \
+  } while (0)
+
+#if REDISCORO_LOG_MIN_LEVEL <= 0
 #define REDISCORO_LOG_DEBUG(fmt, ...)                                              \
   ::rediscoro::get_logger().log(::rediscoro::log_level::debug, __FILE__, __LINE__, \
                                 fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define REDISCORO_LOG_DEBUG(fmt, ...) \
+  REDISCORO_LOG_DISCARD_(::rediscoro::log_level::debug, fmt __VA_OPT__(, ) __VA_ARGS__)
+#endif
 
+#if REDISCORO_LOG_MIN_LEVEL <= 1
 #define REDISCORO_LOG_INFO(fmt, ...)                                              \
   ::rediscoro::get_logger().log(::rediscoro::log_level::info, __FILE__, __LINE__, \
                                 fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define REDISCORO_LOG_INFO(fmt, ...) \
+  REDISCORO_LOG_DISCARD_(::rediscoro::log_level::info, fmt __VA_OPT__(, ) __VA_ARGS__)
+#endif
 
+#if REDISCORO_LOG_MIN_LEVEL <= 2
 #define REDISCORO_LOG_WARNING(fmt, ...)                                              \
   ::rediscoro::get_logger().log(::rediscoro::log_level::warning, __FILE__, __LINE__, \
                                 fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define REDISCORO_LOG_WARNING(fmt, ...) \
+  REDISCORO_LOG_DISCARD_(::rediscoro::log_level::warning, fmt __VA_OPT__(, ) __VA_ARGS__)
+#endif
 
+#if REDISCORO_LOG_MIN_LEVEL <= 3
 #define REDISCORO_LOG_ERROR(fmt, ...)                                              \
   ::rediscoro::get_logger().log(::rediscoro::log_level::error, __FILE__, __LINE__, \
                                 fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define REDISCORO_LOG_ERROR(fmt, ...) \
+  REDISCORO_LOG_DISCARD_(::rediscoro::log_level::error, fmt __VA_OPT__(, ) __VA_ARGS__)
+#endif
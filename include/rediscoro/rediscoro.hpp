@@ -1,11 +1,18 @@
 #pragma once
 
+#include <rediscoro/async_log_sink.hpp>
 #include <rediscoro/client.hpp>
+#include <rediscoro/collapser.hpp>
 #include <rediscoro/config.hpp>
 #include <rediscoro/error.hpp>
 #include <rediscoro/expected.hpp>
 #include <rediscoro/ignore.hpp>
+#include <rediscoro/key_tracker.hpp>
+#include <rediscoro/latency_recorder.hpp>
 #include <rediscoro/logger.hpp>
 #include <rediscoro/request.hpp>
 #include <rediscoro/response.hpp>
+#include <rediscoro/response_stream.hpp>
+#include <rediscoro/slow_request_log.hpp>
+#include <rediscoro/stats.hpp>
 #include <rediscoro/tracing.hpp>
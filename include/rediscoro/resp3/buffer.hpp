@@ -56,6 +56,9 @@ class buffer {
     read_pos_ += n;
   }
 
+  /// Bytes consumed since the last compact() / reset()
+  [[nodiscard]] std::size_t consumed() const { return read_pos_; }
+
   /// Reset buffer to initial state (clears all data)
   auto reset() -> void {
     read_pos_ = 0;
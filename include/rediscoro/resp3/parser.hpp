@@ -65,6 +65,10 @@ class parser {
   /// - compacts the internal buffer (keeps unread bytes)
   auto reclaim() -> void;
 
+  /// Wire size of the message returned by the latest parse_one() (valid until reclaim(), which
+  /// is the only point where the buffer is compacted).
+  [[nodiscard]] auto message_bytes() const noexcept -> std::size_t { return buf_.consumed(); }
+
   [[nodiscard]] auto tree() noexcept -> raw_tree& { return tree_; }
   [[nodiscard]] auto tree() const noexcept -> const raw_tree& { return tree_; }
 
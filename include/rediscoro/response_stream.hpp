@@ -0,0 +1,67 @@
+#pragma once
+
+#include <rediscoro/detail/stream_sink.hpp>
+#include <rediscoro/response.hpp>
+
+#include <iocoro/awaitable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace rediscoro {
+
+/// Replies of one pipeline request, consumed one by one as they arrive (homogeneous slots).
+///
+/// Obtained from `client::exec_stream<T>()`. Unlike `dynamic_response<T>`, replies are not
+/// collected first: `next()` yields each slot as soon as it was received, and at most
+/// `max_buffered` unconsumed slots are held before the connection stops reading (so a huge
+/// pipeline streams with bounded memory). Replies queued behind the stream on the same
+/// connection wait while it is paused.
+///
+/// Destroying the stream before consuming every reply discards the rest (the connection keeps
+/// reading them).
+/// `config::request_timeout` covers the whole stream, consumer pauses included.
+///
+/// Usage:
+///   auto stream = client.exec_stream<std::string>(std::move(req));
+///   while (auto slot = co_await stream.next()) { ... }
+template <typename T>
+class response_stream {
+ public:
+  explicit response_stream(std::shared_ptr<detail::stream_sink<T>> sink)
+      : sink_(std::move(sink)) {}
+
+  response_stream(response_stream&&) noexcept = default;
+  auto operator=(response_stream&& other) noexcept -> response_stream& {
+    if (this != &other) {
+      release();
+      sink_ = std::move(other.sink_);
+    }
+    return *this;
+  }
+  response_stream(response_stream const&) = delete;
+  auto operator=(response_stream const&) -> response_stream& = delete;
+
+  ~response_stream() { release(); }
+
+  /// Next reply slot in order, or nullopt after the last one.
+  /// Must not be called concurrently with itself.
+  auto next() -> iocoro::awaitable<std::optional<response_slot<T>>> { return sink_->next(); }
+
+  /// Total number of replies the stream yields.
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return sink_->expected_replies(); }
+
+ private:
+  auto release() -> void {
+    if (sink_) {
+      sink_->abandon();
+      sink_.reset();
+    }
+  }
+
+  std::shared_ptr<detail::stream_sink<T>> sink_;
+};
+
+}  // namespace rediscoro
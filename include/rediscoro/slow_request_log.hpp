@@ -0,0 +1,85 @@
+#pragma once
+
+#include <rediscoro/tracing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace rediscoro {
+
+/// A request whose end-to-end latency reached `slow_request_options::threshold`.
+///
+/// Timestamps follow `request_trace_phases` (steady clock); a phase that never happened is left
+/// default-constructed.
+struct slow_request_record {
+  using time_point = std::chrono::steady_clock::time_point;
+
+  trace_label command{};  // verb of the first command, upper-cased
+  std::size_t command_count{0};
+  std::size_t request_bytes{0};  // encoded wire size
+  std::size_t reply_bytes{0};    // reply bytes received (0 when none arrived)
+  std::chrono::nanoseconds duration{};
+
+  time_point enqueued{};
+  time_point accepted{};
+  time_point written{};
+  time_point reply_read{};
+  time_point completed{};
+
+  // Connection generation the request was admitted in (see `connection_event::generation`).
+  std::uint64_t generation{0};
+  // First error reported for the request; default constructed on success.
+  std::error_code error{};
+};
+
+/// Fixed-size flight recorder of the most recent slow requests.
+///
+/// Storage for `capacity` records is allocated up front; recording copies a record into the
+/// ring, overwriting the oldest, and never allocates.
+///
+/// Thread-safety: `record()` runs on the connection strand; `snapshot()`/`total()` may run on
+/// any thread (the ring is guarded by a mutex, taken only for slow requests).
+class slow_request_log {
+ public:
+  explicit slow_request_log(std::size_t capacity) : records_(capacity == 0 ? 1 : capacity) {}
+
+  slow_request_log(slow_request_log const&) = delete;
+  auto operator=(slow_request_log const&) -> slow_request_log& = delete;
+
+  auto record(slow_request_record const& r) -> void {
+    std::lock_guard lock(mu_);
+    records_[total_ % records_.size()] = r;
+    total_ += 1;
+  }
+
+  /// Records currently held, oldest first.
+  [[nodiscard]] auto snapshot() const -> std::vector<slow_request_record> {
+    std::lock_guard lock(mu_);
+    auto const n = total_ < records_.size() ? static_cast<std::size_t>(total_) : records_.size();
+    std::vector<slow_request_record> out{};
+    out.reserve(n);
+    for (std::uint64_t i = total_ - n; i < total_; ++i) {
+      out.push_back(records_[i % records_.size()]);
+    }
+    return out;
+  }
+
+  /// Slow requests recorded so far, including overwritten ones.
+  [[nodiscard]] auto total() const -> std::uint64_t {
+    std::lock_guard lock(mu_);
+    return total_;
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return records_.size(); }
+
+ private:
+  mutable std::mutex mu_{};
+  std::vector<slow_request_record> records_;
+  std::uint64_t total_{0};
+};
+
+}  // namespace rediscoro
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rediscoro {
+
+/// Point-in-time copy of a connection's built-in counters (see `client::stats()`).
+///
+/// Counters are cumulative over the lifetime of the client (they survive reconnects); gauges
+/// reflect the pipeline at the time of the last update on the connection strand. Fields are
+/// read individually, so a snapshot is not an atomic cut across all of them.
+struct connection_stats {
+  // Socket IO of the runtime loops (handshake traffic is not included).
+  std::uint64_t bytes_read{0};
+  std::uint64_t bytes_written{0};
+  std::uint64_t read_ops{0};   // completed socket reads (asynchronous or non-blocking)
+  std::uint64_t write_ops{0};  // completed socket writes
+
+  // RESP3 messages parsed and delivered to the pipeline.
+  std::uint64_t messages_parsed{0};
+
+  // Requests admitted (deferred ones and singleflight followers included) and rejected at
+  // admission.
+  std::uint64_t requests_accepted{0};
+  std::uint64_t requests_rejected{0};
+  std::uint64_t queue_full_rejections{0};  // subset of requests_rejected
+  std::uint64_t requests_deduplicated{0};  // subset of requests_accepted sharing a round trip
+  std::uint64_t timeouts{0};               // request_timeout expirations
+
+  // Lifecycle.
+  std::uint64_t connects{0};     // transitions to OPEN (initial connect, reconnects, failovers)
+  std::uint64_t reconnects{0};   // transitions to OPEN after a runtime failure
+  std::uint64_t disconnects{0};  // runtime failures (OPEN -> FAILED)
+
+  // Health checks (see `health_check_options`).
+  std::uint64_t health_checks{0};          // PINGs sent on idle connections
+  std::uint64_t health_check_failures{0};  // PINGs unanswered within the timeout (half-open)
+  std::uint64_t ping_rtt_us{0};            // round trip of the latest answered PING
+  std::uint64_t ping_rtt_ewma_us{0};       // smoothed round trip (EWMA, weight 1/8)
+
+  // Gauges.
+  std::uint64_t queue_depth{0};          // requests deferred, waiting to be written or answered
+  std::uint64_t pending_write_bytes{0};  // wire bytes not yet written
+};
+
+}  // namespace rediscoro
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <rediscoro/detail/fnv1a.hpp>
 #include <rediscoro/error_info.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string_view>
 #include <system_error>
 
 namespace rediscoro {
@@ -27,12 +31,46 @@ enum class request_kind : std::uint8_t {
   }
 }
 
+/// Short string stored inline in trace events (copied, so it outlives the request).
+/// Longer input is truncated to `capacity` bytes.
+struct trace_label {
+  static constexpr std::size_t capacity = 32;
+
+  std::array<char, capacity> data{};
+  std::uint8_t size{0};
+
+  [[nodiscard]] static constexpr auto from(std::string_view s) noexcept -> trace_label {
+    trace_label out{};
+    out.size = static_cast<std::uint8_t>(std::min(s.size(), capacity));
+    std::copy_n(s.data(), out.size, out.data.begin());
+    return out;
+  }
+
+  [[nodiscard]] constexpr auto view() const noexcept -> std::string_view {
+    return {data.data(), size};
+  }
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool { return size == 0; }
+};
+
+/// Hash reported in `request_trace_info::key_hash` (64-bit FNV-1a), so known keys can be
+/// matched against traces without recording them.
+[[nodiscard]] constexpr auto trace_key_hash(std::string_view key) noexcept -> std::uint64_t {
+  return detail::fnv1a_64(key);
+}
+
 /// Minimal request metadata for tracing callbacks.
 struct request_trace_info {
   std::uint64_t id{};
   request_kind kind{request_kind::user};
   std::size_t command_count{0};
   std::size_t wire_bytes{0};
+
+  // Verb of the first command, upper-cased (attribution per command type).
+  trace_label command{};
+  // First key of the first command (its first argument); only with
+  // `request_trace_hooks::capture_key`. 0 / empty otherwise.
+  std::uint64_t key_hash{0};
+  trace_label key{};  // leading `key_prefix_bytes` bytes of the key
 };
 
 struct request_trace_start {
@@ -54,21 +92,62 @@ struct request_trace_finish {
   std::string_view primary_error_detail{};
 };
 
+/// Phase-level timestamps of a completed request (steady clock).
+///
+/// Consecutive differences break the end-to-end latency down:
+/// - accepted - enqueued: hop onto the connection strand (executor queueing);
+/// - written - accepted: waiting behind other writes plus the socket write itself;
+/// - reply_read - written: network round trip and Redis processing;
+/// - parsed - reply_read: RESP3 parsing of the first reply;
+/// - adapted - parsed: remaining replies and adaptation into the response type;
+/// - resumed - adapted: scheduling of the awaiting coroutine.
+///
+/// A phase that never happened (e.g. a request failed before it was written) is left
+/// default-constructed.
+struct request_trace_phases {
+  using time_point = std::chrono::steady_clock::time_point;
+
+  request_trace_info info{};
+  time_point enqueued{};    // exec()/enqueue call
+  time_point accepted{};    // admitted on the connection strand
+  time_point written{};     // last wire byte handed to the socket
+  time_point reply_read{};  // socket read that completed the first reply returned
+  time_point parsed{};      // first reply parsed and built
+  time_point adapted{};     // all replies adapted (request complete)
+  time_point resumed{};     // awaiting coroutine resumed (unset for response streams)
+};
+
 /// Lightweight tracing hooks (no logging dependency).
 ///
 /// Threading / performance contract:
-/// - Callbacks are invoked on the connection strand.
+/// - `on_start` / `on_finish` are invoked on the connection strand.
+/// - `on_phases` is invoked on the executor of the coroutine awaiting the reply, right after it
+///   resumes (on the connection strand for response streams). Setting it adds a few clock reads
+///   per request.
 /// - Implementations MUST be non-blocking and MUST NOT throw.
+///
+/// Sampling: with `sample_every = N`, one request in N (counted per connection) is traced;
+/// the others skip every hook and all tracing bookkeeping.
 struct request_trace_hooks {
   using on_start_fn = void (*)(void*, request_trace_start const&);
   using on_finish_fn = void (*)(void*, request_trace_finish const&);
+  using on_phases_fn = void (*)(void*, request_trace_phases const&);
 
   void* user_data{};
   on_start_fn on_start{};
   on_finish_fn on_finish{};
+  on_phases_fn on_phases{};
+
+  // Trace one request in `sample_every` (0 and 1 trace every request).
+  std::uint32_t sample_every{1};
+  // Fill `request_trace_info::key_hash` from the first key of the request.
+  bool capture_key{false};
+  // Also copy up to this many leading key bytes into `request_trace_info::key` (capped at
+  // `trace_label::capacity`). Keys may hold user data: keep 0 unless that is acceptable.
+  std::size_t key_prefix_bytes{0};
 
   [[nodiscard]] constexpr bool enabled() const noexcept {
-    return on_start != nullptr || on_finish != nullptr;
+    return on_start != nullptr || on_finish != nullptr || on_phases != nullptr;
   }
 };
 
@@ -100,6 +179,7 @@ enum class connection_event_stage : std::uint8_t {
   reconnect,
   close,
   actor,
+  failover,
 };
 
 [[nodiscard]] constexpr auto to_string(connection_event_stage stage) noexcept -> char const* {
@@ -118,6 +198,8 @@ enum class connection_event_stage : std::uint8_t {
       return "close";
     case connection_event_stage::actor:
       return "actor";
+    case connection_event_stage::failover:
+      return "failover";
     default:
       return "unknown";
   }
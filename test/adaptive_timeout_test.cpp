@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/config.hpp>
+#include <rediscoro/detail/adaptive_timeout.hpp>
+#include <rediscoro/request.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+using namespace std::chrono_literals;
+
+using rediscoro::detail::adaptive_timeout;
+
+namespace {
+
+auto options() -> rediscoro::adaptive_timeout_options {
+  return rediscoro::adaptive_timeout_options{
+    .enabled = true,
+    .percentile = 99.0,
+    .multiplier = 4.0,
+    .min_timeout = 1ms,
+    .min_samples = 10,
+    .window = 1s,
+  };
+}
+
+auto budget_of(adaptive_timeout& model, rediscoro::request const& req,
+               adaptive_timeout::clock::time_point now) -> adaptive_timeout::budget {
+  return model.budget_for(req.wire(), req.command_count(), now);
+}
+
+// Record `n` samples of `d` for `req`'s class.
+auto feed(adaptive_timeout& model, rediscoro::request const& req,
+          adaptive_timeout::clock::time_point now, std::chrono::nanoseconds d, int n) -> void {
+  for (int i = 0; i < n; ++i) {
+    auto const b = budget_of(model, req, now);
+    ASSERT_NE(b.window, nullptr);
+    b.window->record(d);
+  }
+}
+
+}  // namespace
+
+TEST(adaptive_timeout_test, falls_back_to_ceiling_until_a_window_has_enough_samples) {
+  auto const t0 = adaptive_timeout::clock::now();
+  adaptive_timeout model{options(), 5000ms, t0};
+  rediscoro::request get{"GET", "k"};
+
+  EXPECT_EQ(budget_of(model, get, t0).timeout, std::optional{5000ms});
+  feed(model, get, t0, 2ms, 9);
+  EXPECT_EQ(budget_of(model, get, t0 + 1s).timeout, std::optional{5000ms});  // 9 < min_samples
+
+  feed(model, get, t0 + 1s, 2ms, 10);
+  auto const budget = budget_of(model, get, t0 + 2s).timeout;
+  ASSERT_TRUE(budget.has_value());
+  EXPECT_GE(*budget, 8ms);
+  EXPECT_LE(*budget, 9ms);  // 4 x p99 (within histogram precision)
+  EXPECT_EQ(model.class_timeout("get"), budget);
+
+  // A quiet window drops the class back to the ceiling.
+  EXPECT_EQ(budget_of(model, get, t0 + 3s).timeout, std::optional{5000ms});
+  EXPECT_FALSE(model.class_timeout("GET").has_value());
+}
+
+TEST(adaptive_timeout_test, budgets_are_clamped_and_tracked_per_class) {
+  auto const t0 = adaptive_timeout::clock::now();
+  auto opts = options();
+  opts.min_timeout = 50ms;
+  adaptive_timeout model{opts, 1000ms, t0};
+  rediscoro::request get{"GET", "k"};
+  rediscoro::request keys{"KEYS", "*"};
+  rediscoro::request sort{"sort", "big"};
+
+  feed(model, get, t0, 100us, 20);
+  feed(model, keys, t0, 20ms, 20);
+  feed(model, sort, t0, 2s, 20);
+
+  auto const now = t0 + 1s;
+  EXPECT_EQ(budget_of(model, get, now).timeout, std::optional{50ms});  // floor
+  EXPECT_EQ(budget_of(model, sort, now).timeout, std::optional{1000ms});  // ceiling
+  auto const k = budget_of(model, keys, now).timeout;
+  ASSERT_TRUE(k.has_value());
+  EXPECT_GE(*k, 80ms);
+  EXPECT_LE(*k, 84ms);
+  EXPECT_EQ(model.class_timeout("SORT"), std::optional{1000ms});
+}
+
+TEST(adaptive_timeout_test, pipelines_and_blocking_commands_keep_the_ceiling) {
+  auto const t0 = adaptive_timeout::clock::now();
+  adaptive_timeout model{options(), std::nullopt, t0};
+
+  rediscoro::request pipeline{};
+  pipeline.push("GET", "a");
+  pipeline.push("GET", "b");
+  rediscoro::request blpop{"BLPOP", "q", "0"};
+  rediscoro::request xread{"XREAD", "BLOCK", "0", "STREAMS", "s", "$"};
+  rediscoro::request wait{"WAIT", "1", "100"};
+
+  for (auto const* req : {&pipeline, &blpop, &xread, &wait}) {
+    auto const b = budget_of(model, *req, t0);
+    EXPECT_FALSE(b.timeout.has_value());  // no ceiling configured
+    EXPECT_EQ(b.window, nullptr);
+  }
+
+  // Without a ceiling, a single command gets no deadline until its class is measured.
+  rediscoro::request get{"GET", "k"};
+  EXPECT_FALSE(budget_of(model, get, t0).timeout.has_value());
+  feed(model, get, t0, 1ms, 10);
+  EXPECT_TRUE(budget_of(model, get, t0 + 1s).timeout.has_value());
+}
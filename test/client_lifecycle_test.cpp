@@ -3,6 +3,8 @@
 #include <rediscoro/client.hpp>
 #include <rediscoro/config.hpp>
 #include <rediscoro/error.hpp>
+#include <rediscoro/ignore.hpp>
+#include <rediscoro/logger.hpp>
 
 #include <iocoro/co_sleep.hpp>
 #include <iocoro/iocoro.hpp>
@@ -11,6 +13,7 @@
 #include <chrono>
 #include <cstdint>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -226,6 +229,56 @@ TEST(client_lifecycle_test, initial_connect_failure_emits_disconnected_and_retur
   ASSERT_TRUE(ok) << diag;
 }
 
+TEST(client_lifecycle_test, close_during_hanging_connect_returns_promptly) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  event_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    // A blackholed address: the SYN is never answered, and nothing bounds the attempt.
+    auto cfg = make_cfg(kRedisPort, &recorder);
+    cfg.host = "10.255.255.1";
+    cfg.connect_timeout = std::nullopt;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto connecting = iocoro::co_spawn(ctx.get_executor(), c.connect(), iocoro::use_awaitable);
+    co_await iocoro::co_sleep(100ms);
+
+    auto const t0 = std::chrono::steady_clock::now();
+    co_await c.close();
+    auto r = co_await std::move(connecting);
+    auto const elapsed = std::chrono::steady_clock::now() - t0;
+
+    if (r.has_value()) {
+      diag = "expected connect to fail after close";
+      co_return;
+    }
+    if (elapsed > 1s) {
+      auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+      diag = "close waited for the connect attempt: " + std::to_string(ms.count()) + "ms";
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
 TEST(client_lifecycle_test, runtime_disconnect_triggers_reconnect_then_connected_again) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
@@ -318,6 +371,351 @@ TEST(client_lifecycle_test, runtime_disconnect_triggers_reconnect_then_connected
   ASSERT_TRUE(ok) << diag;
 }
 
+TEST(client_lifecycle_test, slow_request_dump_logs_each_record_once) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  struct log_capture {
+    std::mutex mu;
+    int echo_lines = 0;
+    int dumps = 0;
+
+    static auto on_log(void* user_data, rediscoro::log_context const& lc) -> void {
+      auto* self = static_cast<log_capture*>(user_data);
+      std::lock_guard lock(self->mu);
+      if (lc.message.starts_with("slow requests before disconnect")) {
+        self->dumps += 1;
+      } else if (lc.message.starts_with("slow request: command=ECHO ")) {
+        self->echo_lines += 1;
+      }
+    }
+  };
+  log_capture capture{};
+  auto const previous_level = rediscoro::logger::instance().get_log_level();
+  rediscoro::set_log_function(&log_capture::on_log, &capture);
+  rediscoro::set_log_level(rediscoro::log_level::warning);
+
+  event_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+    auto cfg = make_cfg(kRedisPort, &recorder);
+    cfg.reconnection.enabled = true;
+    cfg.reconnection.immediate_attempts = 1;
+    cfg.reconnection.initial_delay = 10ms;
+    cfg.reconnection.max_delay = 20ms;
+    cfg.slow_requests.enabled = true;
+    cfg.slow_requests.threshold = 0us;  // record everything
+    cfg.slow_requests.capacity = 256;
+
+    rediscoro::config admin_cfg = cfg;
+    admin_cfg.connection_hooks = {};
+    admin_cfg.slow_requests.enabled = false;
+    rediscoro::client c{ctx.get_executor(), cfg};
+    rediscoro::client admin{ctx.get_executor(), admin_cfg};
+
+    // Kill `c`'s connection and wait until it is served by a new one.
+    auto kill_and_reconnect = [&]() -> iocoro::awaitable<bool> {
+      auto id_resp = co_await c.exec<std::int64_t>("CLIENT", "ID");
+      if (!id_resp.get<0>()) {
+        diag = "CLIENT ID failed: " + id_resp.get<0>().error().to_string();
+        co_return false;
+      }
+      auto const victim_id = *id_resp.get<0>();
+      auto kill_resp = co_await admin.exec<std::int64_t>("CLIENT", "KILL", "ID", victim_id);
+      if (!kill_resp.get<0>() || *kill_resp.get<0>() < 1) {
+        diag = "CLIENT KILL failed for slow request dump test";
+        co_return false;
+      }
+      for (int i = 0; i < 80; ++i) {
+        auto id2_resp = co_await c.exec<std::int64_t>("CLIENT", "ID");
+        if (id2_resp.get<0>() && *id2_resp.get<0>() != victim_id) {
+          co_return true;
+        }
+        co_await iocoro::co_sleep(20ms);
+      }
+      diag = "did not observe a new CLIENT ID after reconnect";
+      co_return false;
+    };
+
+    bool pass = false;
+    do {
+      auto cr = co_await connect_with_retry(c);
+      auto acr = co_await connect_with_retry(admin);
+      if (!cr || !acr) {
+        diag = "connect failed";
+        break;
+      }
+
+      // Recorded once, before the first disconnect; no later dump may repeat it.
+      auto echo = co_await c.exec<std::string>("ECHO", "slow");
+      if (!echo.get<0>()) {
+        diag = "ECHO failed: " + echo.get<0>().error().to_string();
+        break;
+      }
+      if (!co_await kill_and_reconnect() || !co_await kill_and_reconnect()) {
+        break;
+      }
+
+      std::lock_guard lock(capture.mu);
+      if (capture.dumps != 2) {
+        diag = "expected one dump per disconnect, got " + std::to_string(capture.dumps);
+        break;
+      }
+      if (capture.echo_lines != 1) {
+        diag = "ECHO logged " + std::to_string(capture.echo_lines) + " times";
+        break;
+      }
+      pass = true;
+    } while (false);
+
+    co_await admin.close();
+    co_await c.close();
+    if (pass) {
+      // close() dumps what the polls after the second reconnect recorded.
+      std::lock_guard lock(capture.mu);
+      if (capture.dumps != 3 || capture.echo_lines != 1) {
+        diag = "expected close() to dump only new records: dumps=" +
+               std::to_string(capture.dumps) + " echo=" + std::to_string(capture.echo_lines);
+      } else {
+        ok = true;
+      }
+    }
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  rediscoro::set_log_function(nullptr);
+  rediscoro::set_log_level(previous_level);
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_lifecycle_test, offline_buffer_replays_requests_across_reconnect) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  event_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+    auto cfg = make_cfg(kRedisPort, &recorder);
+    cfg.reconnection.enabled = true;
+    cfg.reconnection.immediate_attempts = 0;
+    cfg.reconnection.initial_delay = 50ms;
+    cfg.reconnection.max_delay = 50ms;
+    cfg.offline_buffer.enabled = true;
+
+    rediscoro::config admin_cfg = cfg;
+    admin_cfg.connection_hooks = {};
+    admin_cfg.offline_buffer.enabled = false;
+    rediscoro::client c{ctx.get_executor(), cfg};
+    rediscoro::client admin{ctx.get_executor(), admin_cfg};
+
+    bool pass = false;
+    do {
+      auto cr = co_await connect_with_retry(c);
+      if (!cr) {
+        diag = "initial connect failed: " + cr.error().to_string();
+        break;
+      }
+      auto acr = co_await connect_with_retry(admin);
+      if (!acr) {
+        diag = "admin connect failed: " + acr.error().to_string();
+        break;
+      }
+
+      const std::string key = "rediscoro:test:offline_buffer:" + unique_key_suffix();
+      auto set_resp = co_await c.exec<std::string>("SET", key, "v");
+      auto id_resp = co_await c.exec<std::int64_t>("CLIENT", "ID");
+      if (!set_resp.get<0>() || !id_resp.get<0>()) {
+        diag = "setup failed";
+        break;
+      }
+      const std::int64_t victim_id = *id_resp.get<0>();
+
+      auto kill_resp = co_await admin.exec<std::int64_t>("CLIENT", "KILL", "ID", victim_id);
+      if (!kill_resp.get<0>() || *kill_resp.get<0>() < 1) {
+        diag = "CLIENT KILL failed for offline buffer test";
+        break;
+      }
+
+      // Issued right after the kill: each read either rides the dead connection (and is
+      // replayed) or is buffered until the reconnect completes. None may fail.
+      auto ex = ctx.get_executor();
+      std::vector<iocoro::awaitable<rediscoro::response<std::string>>> reads{};
+      for (int i = 0; i < 8; ++i) {
+        reads.push_back(
+          iocoro::co_spawn(ex, c.exec<std::string>("GET", key), iocoro::use_awaitable));
+      }
+      bool all_ok = true;
+      for (auto& read : reads) {
+        auto resp = co_await std::move(read);
+        if (!resp.get<0>() || *resp.get<0>() != "v") {
+          diag = resp.get<0>() ? "unexpected GET value"
+                               : "GET failed: " + resp.get<0>().error().to_string();
+          all_ok = false;
+        }
+      }
+      if (!all_ok) {
+        break;
+      }
+
+      auto id2_resp = co_await c.exec<std::int64_t>("CLIENT", "ID");
+      if (!id2_resp.get<0>() || *id2_resp.get<0>() == victim_id) {
+        diag = "expected a new connection after the kill";
+        break;
+      }
+      (void)co_await c.exec<rediscoro::ignore_t>("DEL", key);
+
+      pass = true;
+    } while (false);
+
+    co_await admin.close();
+    co_await c.close();
+    if (pass) {
+      ok = true;
+    }
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_lifecycle_test, standby_is_promoted_when_active_connection_fails) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  event_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+    auto cfg = make_cfg(kRedisPort, &recorder);
+    cfg.client_name = "rediscoro-standby-" + unique_key_suffix();
+    cfg.reconnection.enabled = true;
+    // A regular reconnect would take seconds: only a failover can restore service quickly.
+    cfg.reconnection.immediate_attempts = 0;
+    cfg.reconnection.initial_delay = 5s;
+    cfg.reconnection.max_delay = 5s;
+    cfg.standby.enabled = true;
+
+    rediscoro::config admin_cfg = make_cfg(kRedisPort, nullptr);
+    admin_cfg.connection_hooks = {};
+    rediscoro::client c{ctx.get_executor(), cfg};
+    rediscoro::client admin{ctx.get_executor(), admin_cfg};
+
+    auto count_named = [&]() -> iocoro::awaitable<int> {
+      auto list = co_await admin.exec<std::string>("CLIENT", "LIST");
+      if (!list.get<0>()) {
+        co_return -1;
+      }
+      int n = 0;
+      auto const needle = "name=" + cfg.client_name + " ";
+      for (auto pos = list.get<0>()->find(needle); pos != std::string::npos;
+           pos = list.get<0>()->find(needle, pos + 1)) {
+        n += 1;
+      }
+      co_return n;
+    };
+
+    bool pass = false;
+    do {
+      auto cr = co_await connect_with_retry(c);
+      auto acr = co_await connect_with_retry(admin);
+      if (!cr || !acr) {
+        diag = "connect failed";
+        break;
+      }
+
+      bool standby_seen = false;
+      for (int i = 0; i < 100 && !standby_seen; ++i) {
+        standby_seen = (co_await count_named()) == 2;
+        if (!standby_seen) {
+          co_await iocoro::co_sleep(10ms);
+        }
+      }
+      if (!standby_seen) {
+        diag = "standby connection did not appear";
+        break;
+      }
+
+      auto id_resp = co_await c.exec<std::int64_t>("CLIENT", "ID");
+      if (!id_resp.get<0>()) {
+        diag = "CLIENT ID failed: " + id_resp.get<0>().error().to_string();
+        break;
+      }
+      const std::int64_t active_id = *id_resp.get<0>();
+      auto kill_resp = co_await admin.exec<std::int64_t>("CLIENT", "KILL", "ID", active_id);
+      if (!kill_resp.get<0>() || *kill_resp.get<0>() < 1) {
+        diag = "CLIENT KILL failed for standby test";
+        break;
+      }
+
+      auto const killed_at = std::chrono::steady_clock::now();
+      bool served = false;
+      while (!served && std::chrono::steady_clock::now() - killed_at < 1s) {
+        auto id2_resp = co_await c.exec<std::int64_t>("CLIENT", "ID");
+        served = id2_resp.get<0>() && *id2_resp.get<0>() != active_id;
+        if (!served) {
+          co_await iocoro::co_sleep(5ms);
+        }
+      }
+      if (!served) {
+        diag = "no failover within 1s of losing the active connection";
+        break;
+      }
+
+      bool failover_event = false;
+      for (auto const& ev : recorder.snapshot()) {
+        if (ev.kind == rediscoro::connection_event_kind::connected &&
+            ev.stage == rediscoro::connection_event_stage::failover) {
+          failover_event = true;
+        }
+      }
+      if (!failover_event) {
+        diag = "expected a connected event with stage=failover";
+        break;
+      }
+
+      pass = true;
+    } while (false);
+
+    co_await admin.close();
+    co_await c.close();
+    if (pass) {
+      ok = true;
+    }
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
 TEST(client_lifecycle_test, runtime_disconnect_with_reconnect_disabled_ends_in_closed) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
@@ -562,6 +960,73 @@ TEST(client_lifecycle_test, request_timeout_fails_inflight_and_emits_disconnecte
   ASSERT_TRUE(ok) << diag;
 }
 
+TEST(client_lifecycle_test, blocking_lane_keeps_main_pipeline_flowing) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  event_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    auto cfg = make_cfg(kRedisPort, &recorder);
+    cfg.request_timeout = 200ms;
+    cfg.reconnection.enabled = false;
+    cfg.blocking_lane.enabled = true;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto cr = co_await connect_with_retry(c);
+    if (!cr) {
+      diag = "connect failed: " + cr.error().to_string();
+      co_return;
+    }
+
+    const std::string key = "rediscoro:test:blocking_lane:" + unique_key_suffix();
+    (void)co_await c.exec<std::int64_t>("DEL", key);
+
+    // Blocks longer than request_timeout: must neither time out nor hold up the PING below.
+    auto blpop = iocoro::co_spawn(ctx.get_executor(),
+                                  c.exec<rediscoro::ignore_t>("BLPOP", key, "1"),
+                                  iocoro::use_awaitable);
+    co_await iocoro::co_sleep(20ms);
+
+    auto ping = co_await c.exec<std::string>("PING");
+    if (!ping.get<0>()) {
+      diag = "PING behind BLPOP failed: " + ping.get<0>().error().to_string();
+      co_return;
+    }
+
+    auto resp = co_await std::move(blpop);
+    if (!resp.get<0>()) {
+      diag = "expected BLPOP to time out on the server, got: " + resp.get<0>().error().to_string();
+      co_return;
+    }
+
+    for (auto const& ev : recorder.snapshot()) {
+      if (ev.kind == rediscoro::connection_event_kind::disconnected) {
+        diag = "unexpected disconnected event: " + ev.error.to_string();
+        co_return;
+      }
+    }
+
+    co_await c.close();
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
 TEST(client_lifecycle_test, close_is_idempotent_under_inflight_requests) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
@@ -3,10 +3,15 @@
 #include <rediscoro/client.hpp>
 #include <rediscoro/config.hpp>
 
+#include <iocoro/co_sleep.hpp>
 #include <iocoro/iocoro.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -28,6 +33,78 @@ auto submit_ping_expect_not_connected(rediscoro::client* client_ptr,
   co_return;
 }
 
+struct scenario_outcome {
+  bool skipped = false;
+  std::string skip_reason{};
+  std::vector<std::string> transcript{};
+};
+
+// Concurrent mixed requests (including a server error), then use after close. Every reply is
+// recorded in submission order so runs with different executor bindings can be compared.
+auto run_mixed_request_scenario(bool single_threaded) -> scenario_outcome {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+  scenario_outcome out{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.single_threaded = single_threaded;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      out.skipped = true;
+      out.skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    auto record = [](auto const& slot) -> std::string {
+      if (!slot) {
+        return "error: " + slot.error().to_string();
+      }
+      std::ostringstream os{};
+      os << "value: " << *slot;
+      return os.str();
+    };
+
+    const std::string key = "rediscoro:test:executor_binding";
+    auto ex = ctx.get_executor();
+    auto del = iocoro::co_spawn(ex, c.exec<std::int64_t>("DEL", key), iocoro::use_awaitable);
+    auto set = iocoro::co_spawn(ex, c.exec<std::string>("SET", key, "v"), iocoro::use_awaitable);
+    auto get = iocoro::co_spawn(ex, c.exec<std::string>("GET", key), iocoro::use_awaitable);
+    auto incr = iocoro::co_spawn(ex, c.exec<std::int64_t>("INCR", key), iocoro::use_awaitable);
+    auto append =
+      iocoro::co_spawn(ex, c.exec<std::int64_t>("APPEND", key, "x"), iocoro::use_awaitable);
+    auto get2 = iocoro::co_spawn(ex, c.exec<std::string>("GET", key), iocoro::use_awaitable);
+
+    out.transcript.push_back(record((co_await std::move(del)).get<0>()));
+    out.transcript.push_back(record((co_await std::move(set)).get<0>()));
+    out.transcript.push_back(record((co_await std::move(get)).get<0>()));
+    out.transcript.push_back(record((co_await std::move(incr)).get<0>()));
+    out.transcript.push_back(record((co_await std::move(append)).get<0>()));
+    out.transcript.push_back(record((co_await std::move(get2)).get<0>()));
+
+    co_await c.close();
+    out.transcript.push_back(record((co_await c.exec<std::string>("PING")).get<0>()));
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+  return out;
+}
+
 }  // namespace
 
 TEST(client_test, exec_without_connect_is_rejected) {
@@ -43,16 +120,1284 @@ TEST(client_test, exec_without_connect_is_rejected) {
     cfg.reconnection.enabled = false;
 
     rediscoro::client c{ctx.get_executor(), cfg};
-    auto resp = co_await c.exec<std::string>("PING");
-    if (resp.get<0>().has_value()) {
-      diag = "expected not_connected error, got value";
+    auto resp = co_await c.exec<std::string>("PING");
+    if (resp.get<0>().has_value()) {
+      diag = "expected not_connected error, got value";
+      co_return;
+    }
+    if (resp.get<0>().error().code != rediscoro::client_errc::not_connected) {
+      diag = "expected not_connected, got: " + resp.get<0>().error().to_string();
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, single_threaded_exec_without_connect_is_rejected) {
+  iocoro::io_context ctx;
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.reconnection.enabled = false;
+    cfg.single_threaded = true;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto resp = co_await c.exec<std::string>("PING");
+    if (resp.get<0>().has_value()) {
+      diag = "expected not_connected error, got value";
+      co_return;
+    }
+    if (resp.get<0>().error().code != rediscoro::client_errc::not_connected) {
+      diag = "expected not_connected, got: " + resp.get<0>().error().to_string();
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, single_threaded_binding_matches_strand_semantics) {
+  auto const stranded = run_mixed_request_scenario(false);
+  if (stranded.skipped) {
+    GTEST_SKIP() << stranded.skip_reason;
+  }
+  auto const direct = run_mixed_request_scenario(true);
+  ASSERT_FALSE(direct.skipped) << direct.skip_reason;
+
+  ASSERT_EQ(stranded.transcript.size(), 7U);
+  EXPECT_EQ(stranded.transcript[1], "value: OK");
+  EXPECT_EQ(stranded.transcript[2], "value: v");
+  EXPECT_EQ(stranded.transcript[5], "value: vx");
+  EXPECT_EQ(direct.transcript, stranded.transcript);
+}
+
+TEST(client_test, exec_batch_without_connect_rejects_every_request) {
+  iocoro::io_context ctx;
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    std::vector<rediscoro::request> reqs{};
+    reqs.emplace_back("PING");
+    reqs.emplace_back("GET", "k");
+    auto results = co_await c.exec_batch<std::string>(std::move(reqs));
+    if (results.size() != 2) {
+      diag = "expected two results, got " + std::to_string(results.size());
+      co_return;
+    }
+    for (auto const& result : results) {
+      if (result.size() != 1 || result[0].has_value() ||
+          result[0].error().code != rediscoro::client_errc::not_connected) {
+        diag = "expected not_connected for every request";
+        co_return;
+      }
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, stats_count_rejected_requests_without_connect) {
+  iocoro::io_context ctx;
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    (void)co_await c.exec<std::string>("PING");
+    (void)co_await c.exec<std::string>("GET", "k");
+
+    auto const s = c.stats();
+    if (s.requests_rejected != 2 || s.requests_accepted != 0 || s.queue_full_rejections != 0 ||
+        s.connects != 0 || s.bytes_written != 0 || s.queue_depth != 0) {
+      diag = "unexpected stats: rejected=" + std::to_string(s.requests_rejected) +
+             " accepted=" + std::to_string(s.requests_accepted);
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, resolve_timeout_zero_is_reported) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    // Deterministic: resolve_timeout = 0ms makes with_timeout immediately time out.
+    cfg.host = "qq.com";
+    cfg.port = 80;
+    cfg.resolve_timeout = 0ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (r.has_value()) {
+      diag = "expected resolve_timeout, got success";
+      co_return;
+    }
+    if (r.error().code != rediscoro::client_errc::resolve_timeout) {
+      diag = "expected resolve_timeout, got: " + r.error().to_string();
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, timeout_error_is_reported_for_unresponsive_peer) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "10.255.255.1";
+    cfg.port = 6379;
+    cfg.connect_timeout = 50ms;
+    cfg.resolve_timeout = 50ms;
+    cfg.request_timeout = 50ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (r.has_value()) {
+      diag = "unexpected success connecting to blackhole address";
+      co_return;
+    }
+
+    auto const e = r.error();
+
+    // Depending on routing, we may time out at TCP connect or during the handshake read/write.
+    if (!(e.code == rediscoro::client_errc::connect_timeout ||
+          e.code == rediscoro::client_errc::handshake_timeout ||
+          e.code == rediscoro::client_errc::connect_failed ||
+          e.code == rediscoro::client_errc::resolve_failed ||
+          e.code == rediscoro::client_errc::resolve_timeout ||
+          e.code == rediscoro::client_errc::connection_reset ||
+          e.code == rediscoro::client_errc::operation_aborted)) {
+      diag = "expected timeout/connect failure, got: " + e.to_string();
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, connect_fails_with_queue_full_when_handshake_push_rejected) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.limits.pipeline.max_requests = 0;
+    cfg.limits.pipeline.max_pending_write_bytes = 0;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (r.has_value()) {
+      diag = "expected queue_full on handshake enqueue, got success";
+      co_return;
+    }
+
+    if (r.error().code == rediscoro::client_errc::queue_full) {
+      ok = true;
+      co_return;
+    }
+
+    if (r.error().code == rediscoro::client_errc::resolve_timeout ||
+        r.error().code == rediscoro::client_errc::connect_timeout ||
+        r.error().code == rediscoro::client_errc::connect_failed ||
+        r.error().code == rediscoro::client_errc::resolve_failed ||
+        r.error().code == rediscoro::client_errc::connection_reset ||
+        r.error().code == rediscoro::client_errc::operation_aborted) {
+      skipped = true;
+      skip_reason =
+        "redis not available for handshake queue_full test (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    diag = "expected queue_full, got: " + r.error().to_string();
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, ping_set_get_roundtrip) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    {
+      auto resp = co_await c.exec<std::string>("PING");
+      auto& slot = resp.get<0>();
+      if (!slot) {
+        diag = "PING failed: " + slot.error().to_string();
+        co_return;
+      }
+      if (*slot != "PONG") {
+        diag = "expected PONG, got: " + *slot;
+        co_return;
+      }
+    }
+
+    const std::string key = "rediscoro:test:ping_set_get_roundtrip";
+    const std::string value = "42";
+
+    {
+      auto resp = co_await c.exec<std::int64_t>("DEL", key);
+      auto& slot = resp.get<0>();
+      if (!slot) {
+        diag = "DEL failed: " + slot.error().to_string();
+        co_return;
+      }
+    }
+
+    {
+      auto resp = co_await c.exec<std::string>("SET", key, value);
+      auto& slot = resp.get<0>();
+      if (!slot) {
+        diag = "SET failed: " + slot.error().to_string();
+        co_return;
+      }
+      if (*slot != "OK") {
+        diag = "expected OK from SET, got: " + *slot;
+        co_return;
+      }
+    }
+
+    {
+      auto resp = co_await c.exec<std::string>("GET", key);
+      auto& slot = resp.get<0>();
+      if (!slot) {
+        diag = "GET failed: " + slot.error().to_string();
+        co_return;
+      }
+      if (*slot != value) {
+        diag = "expected GET value " + value + ", got: " + *slot;
+        co_return;
+      }
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, staggered_connect_over_localhost_endpoints) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    // "localhost" commonly resolves to both ::1 and 127.0.0.1; with a tiny attempt delay the
+    // attempts overlap and exactly one connection must win.
+    rediscoro::config cfg{};
+    cfg.host = "localhost";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.connect_attempt_delay = 1ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at localhost:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    auto resp = co_await c.exec<std::string>("PING");
+    if (!resp.get<0>()) {
+      diag = "PING failed: " + resp.get<0>().error().to_string();
+      co_return;
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, pipelined_handshake_fails_queued_requests_with_connect_error) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    // Nothing listens on port 1: the connect fails and takes the queued request with it.
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 1;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.pipelined_handshake = true;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto connecting = iocoro::co_spawn(ctx.get_executor(), c.connect(), iocoro::use_awaitable);
+    auto resp = co_await c.exec<std::string>("PING");
+    auto r = co_await std::move(connecting);
+    if (r.has_value()) {
+      diag = "unexpected successful connect to 127.0.0.1:1";
+      co_return;
+    }
+
+    auto& slot = resp.get<0>();
+    if (slot.has_value()) {
+      diag = "expected queued PING to fail, got value";
+      co_return;
+    }
+    if (slot.error().code != r.error().code) {
+      diag = "expected connect error " + r.error().to_string() + ", got " +
+             slot.error().to_string();
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, pipelined_handshake_serves_requests_queued_while_connecting) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.client_name = "rediscoro-pipelined-handshake";
+    cfg.pipelined_handshake = true;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto ex = ctx.get_executor();
+    auto connecting = iocoro::co_spawn(ex, c.connect(), iocoro::use_awaitable);
+
+    // Submitted while CONNECTING: queued and written behind the handshake.
+    auto ping = iocoro::co_spawn(ex, c.exec<std::string>("PING"), iocoro::use_awaitable);
+    auto name = iocoro::co_spawn(ex, c.exec<std::string>("CLIENT", "GETNAME"),
+                                 iocoro::use_awaitable);
+
+    auto r = co_await std::move(connecting);
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      (void)co_await std::move(ping);
+      (void)co_await std::move(name);
+      co_return;
+    }
+
+    auto ping_resp = co_await std::move(ping);
+    if (!ping_resp.get<0>() || *ping_resp.get<0>() != "PONG") {
+      diag = "queued PING failed";
+      co_return;
+    }
+    // Replies are matched in order: the queued request ran after CLIENT SETNAME.
+    auto name_resp = co_await std::move(name);
+    if (!name_resp.get<0>() || *name_resp.get<0>() != cfg.client_name) {
+      diag = "queued CLIENT GETNAME did not observe the handshake";
+      co_return;
+    }
+
+    auto after = co_await c.exec<std::string>("PING");
+    if (!after.get<0>()) {
+      diag = "PING after connect failed: " + after.get<0>().error().to_string();
+      co_return;
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, pipelined_handshake_reports_written_requests_as_outcome_unknown) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    // AUTH fails (no such password configured, or a wrong one); the PING written behind it
+    // still reaches the server.
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.password = "rediscoro-wrong-password";
+    cfg.pipelined_handshake = true;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto ex = ctx.get_executor();
+    auto connecting = iocoro::co_spawn(ex, c.connect(), iocoro::use_awaitable);
+    auto ping = iocoro::co_spawn(ex, c.exec<std::string>("PING"), iocoro::use_awaitable);
+
+    auto r = co_await std::move(connecting);
+    auto resp = co_await std::move(ping);
+    if (r.has_value() || r.error().code != rediscoro::server_errc::redis_error) {
+      skipped = true;
+      skip_reason = "needs a redis at 127.0.0.1:6379 that rejects the test password";
+      co_await c.close();
+      co_return;
+    }
+
+    auto& slot = resp.get<0>();
+    if (slot.has_value() || slot.error().code != rediscoro::client_errc::outcome_unknown) {
+      diag = "expected outcome_unknown for the written PING";
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, pipelined_handshake_connects_with_full_deferred_queue) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.pipelined_handshake = true;
+    cfg.reconnection.enabled = false;
+    cfg.limits.pipeline.max_requests = 2;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto ex = ctx.get_executor();
+    auto connecting = iocoro::co_spawn(ex, c.connect(), iocoro::use_awaitable);
+
+    // Fill the request limit while CONNECTING: the handshake must still be queued.
+    auto first = iocoro::co_spawn(ex, c.exec<std::string>("PING"), iocoro::use_awaitable);
+    auto second = iocoro::co_spawn(ex, c.exec<std::string>("PING"), iocoro::use_awaitable);
+
+    auto r = co_await std::move(connecting);
+    auto first_resp = co_await std::move(first);
+    auto second_resp = co_await std::move(second);
+    if (!r.has_value()) {
+      if (r.error().code == rediscoro::client_errc::queue_full) {
+        diag = "handshake rejected by the user request limit";
+        co_return;
+      }
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    if (!first_resp.get<0>() || !second_resp.get<0>()) {
+      diag = "queued requests failed";
+      co_return;
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, singleflight_identical_reads_all_complete) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.singleflight.enabled = true;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    const std::string key = "rediscoro:test:singleflight";
+    {
+      auto resp = co_await c.exec<std::string>("SET", key, "hot");
+      if (!resp.get<0>()) {
+        diag = "SET failed: " + resp.get<0>().error().to_string();
+        co_return;
+      }
+    }
+
+    // Identical reads share a round trip; a write in between must never be deduplicated.
+    constexpr int kReaders = 32;
+    std::vector<iocoro::awaitable<rediscoro::response<std::string>>> reads{};
+    reads.reserve(kReaders);
+    for (int i = 0; i < kReaders; ++i) {
+      reads.push_back(iocoro::co_spawn(ctx.get_executor(), c.exec<std::string>("GET", key),
+                                       iocoro::use_awaitable));
+    }
+    auto incr = iocoro::co_spawn(ctx.get_executor(), c.exec<std::int64_t>("INCR", key),
+                                 iocoro::use_awaitable);
+
+    for (auto& read : reads) {
+      auto resp = co_await std::move(read);
+      auto& slot = resp.get<0>();
+      if (!slot) {
+        diag = "GET failed: " + slot.error().to_string();
+        co_return;
+      }
+      if (*slot != "hot") {
+        diag = "expected GET value hot, got: " + *slot;
+        co_return;
+      }
+    }
+
+    auto incr_resp = co_await std::move(incr);
+    if (incr_resp.get<0>()) {
+      diag = "expected INCR on a non-integer to fail";
+      co_return;
+    }
+
+    // Followers count as accepted even though they are never written.
+    auto const s = c.stats();
+    co_await c.close();
+    if (s.requests_accepted != kReaders + 2 || s.requests_deduplicated >= kReaders) {
+      diag = "unexpected counters: accepted=" + std::to_string(s.requests_accepted) +
+             " deduplicated=" + std::to_string(s.requests_deduplicated);
+      co_return;
+    }
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, read_ahead_delivers_deep_pipeline_in_order) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.read_ahead.enabled = true;
+    cfg.read_ahead.max_reads = 4;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    // Large replies spread over many reads; each caller must still get its own reply.
+    constexpr int kRequests = 256;
+    std::vector<std::string> payloads{};
+    std::vector<iocoro::awaitable<rediscoro::response<std::string>>> echoes{};
+    payloads.reserve(kRequests);
+    echoes.reserve(kRequests);
+    for (int i = 0; i < kRequests; ++i) {
+      payloads.push_back(std::to_string(i) + std::string(4096, 'x'));
+      echoes.push_back(iocoro::co_spawn(ctx.get_executor(),
+                                        c.exec<std::string>("ECHO", payloads.back()),
+                                        iocoro::use_awaitable));
+    }
+
+    for (int i = 0; i < kRequests; ++i) {
+      auto resp = co_await std::move(echoes[i]);
+      auto& slot = resp.get<0>();
+      if (!slot) {
+        diag = "ECHO failed: " + slot.error().to_string();
+        co_return;
+      }
+      if (*slot != payloads[i]) {
+        diag = "ECHO reply out of order at index " + std::to_string(i);
+        co_return;
+      }
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, inline_resume_completes_concurrent_requests) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.inline_resume = true;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    // Replies of one read resume their callers inline; each caller issues a follow-up request
+    // from the resumed context.
+    auto roundtrip = [&c](int i) -> iocoro::awaitable<std::string> {
+      auto first = co_await c.exec<std::string>("ECHO", std::to_string(i));
+      if (!first.get<0>()) {
+        co_return "error: " + first.get<0>().error().to_string();
+      }
+      auto second = co_await c.exec<std::string>("ECHO", *first.get<0>() + "!");
+      if (!second.get<0>()) {
+        co_return "error: " + second.get<0>().error().to_string();
+      }
+      co_return *second.get<0>();
+    };
+
+    constexpr int kCallers = 64;
+    std::vector<iocoro::awaitable<std::string>> callers{};
+    callers.reserve(kCallers);
+    for (int i = 0; i < kCallers; ++i) {
+      callers.push_back(iocoro::co_spawn(ctx.get_executor(), roundtrip(i), iocoro::use_awaitable));
+    }
+    for (int i = 0; i < kCallers; ++i) {
+      auto got = co_await std::move(callers[i]);
+      if (got != std::to_string(i) + "!") {
+        diag = "unexpected reply for caller " + std::to_string(i) + ": " + got;
+        co_return;
+      }
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, inline_resume_delivers_rejection_on_idle_connection) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.inline_resume = true;
+    cfg.limits.pipeline.max_pending_write_bytes = 64;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    // The read loop is parked in a socket read; the rejection must not wait for its bytes.
+    bool completed = false;
+    std::error_code got{};
+    auto oversized = [&]() -> iocoro::awaitable<void> {
+      auto resp =
+        co_await c.exec<rediscoro::ignore_t>("SET", "rediscoro:big", std::string(256, 'x'));
+      if (!resp.get<0>()) {
+        got = resp.get<0>().error().code;
+      }
+      completed = true;
+    };
+    iocoro::co_spawn(ctx.get_executor(), oversized(), iocoro::detached);
+    co_await iocoro::co_sleep(200ms);
+    co_await c.close();
+
+    if (!completed) {
+      diag = "over-limit request never completed";
+      co_return;
+    }
+    if (got != rediscoro::client_errc::queue_full) {
+      diag = "expected queue_full, got: " + got.message();
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, exec_batch_returns_replies_per_request_in_order) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    // Many single-command requests plus one multi-command request in the middle.
+    constexpr int kRequests = 2000;
+    std::vector<rediscoro::request> reqs{};
+    reqs.reserve(kRequests + 1);
+    for (int i = 0; i < kRequests; ++i) {
+      reqs.emplace_back("ECHO", std::to_string(i));
+      if (i == kRequests / 2) {
+        rediscoro::request multi{};
+        multi.push("ECHO", "a");
+        multi.push("ECHO", "b");
+        reqs.push_back(std::move(multi));
+      }
+    }
+
+    auto results = co_await c.exec_batch<std::string>(std::move(reqs));
+    if (results.size() != static_cast<std::size_t>(kRequests) + 1) {
+      diag = "unexpected result count: " + std::to_string(results.size());
+      co_return;
+    }
+
+    std::size_t idx = 0;
+    for (int i = 0; i < kRequests; ++i, ++idx) {
+      auto const& single = results[idx];
+      if (single.size() != 1 || !single[0] || *single[0] != std::to_string(i)) {
+        diag = "unexpected reply for request " + std::to_string(i);
+        co_return;
+      }
+      if (i == kRequests / 2) {
+        auto const& multi = results[++idx];
+        if (multi.size() != 2 || !multi[0] || !multi[1] || *multi[0] != "a" || *multi[1] != "b") {
+          diag = "unexpected replies for the multi-command request";
+          co_return;
+        }
+      }
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, stats_track_socket_io_and_requests) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    auto const before = c.stats();
+    constexpr int kRequests = 10;
+    std::size_t wire_bytes = 0;
+    for (int i = 0; i < kRequests; ++i) {
+      rediscoro::request req{"ECHO", std::to_string(i)};
+      wire_bytes += req.wire().size();
+      auto resp = co_await c.exec<std::string>(std::move(req));
+      if (!resp.get<0>()) {
+        diag = "ECHO failed: " + resp.get<0>().error().to_string();
+        co_return;
+      }
+    }
+    auto const after = c.stats();
+
+    if (after.connects != 1 || after.reconnects != 0 || after.disconnects != 0) {
+      diag = "unexpected lifecycle counters";
+      co_return;
+    }
+    if (after.requests_accepted - before.requests_accepted != kRequests ||
+        after.messages_parsed - before.messages_parsed != kRequests) {
+      diag = "unexpected request counters: accepted=" + std::to_string(after.requests_accepted) +
+             " parsed=" + std::to_string(after.messages_parsed);
+      co_return;
+    }
+    if (after.bytes_written - before.bytes_written != wire_bytes ||
+        after.write_ops <= before.write_ops || after.read_ops <= before.read_ops ||
+        after.bytes_read <= before.bytes_read) {
+      diag = "unexpected socket counters";
+      co_return;
+    }
+    if (after.queue_depth != 0 || after.pending_write_bytes != 0) {
+      diag = "queue gauges not drained";
+      co_return;
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, latency_recorder_collects_per_command_histograms) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto recorder = std::make_shared<rediscoro::latency_recorder>();
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.latency = recorder;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    for (int i = 0; i < 5; ++i) {
+      (void)co_await c.exec<rediscoro::ignore_t>("SET", "rediscoro:latency", std::to_string(i));
+      (void)co_await c.exec<std::string>("get", "rediscoro:latency");
+    }
+    (void)co_await c.exec<std::string>("PING");
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+  // The handshake is not a user request and is not recorded.
+  EXPECT_EQ(recorder->overall().count(), 11U);
+  ASSERT_NE(recorder->find("SET"), nullptr);
+  ASSERT_NE(recorder->find("GET"), nullptr);
+  ASSERT_NE(recorder->find("PING"), nullptr);
+  EXPECT_EQ(recorder->find("SET")->count(), 5U);
+  EXPECT_EQ(recorder->find("GET")->count(), 5U);
+  EXPECT_EQ(recorder->find("PING")->count(), 1U);
+  EXPECT_EQ(recorder->find("HELLO"), nullptr);
+  EXPECT_GT(recorder->overall().summary().p50.count(), 0);
+}
+
+TEST(client_test, key_tracking_reports_hot_and_big_keys) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto tracker = std::make_shared<rediscoro::key_tracker>();
+  std::string const big(64 * 1024, 'x');
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+    cfg.key_tracking = tracker;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
       co_return;
     }
-    if (resp.get<0>().error().code != rediscoro::client_errc::not_connected) {
-      diag = "expected not_connected, got: " + resp.get<0>().error().to_string();
-      co_return;
+
+    (void)co_await c.exec<rediscoro::ignore_t>("SET", "rediscoro:keys:big", big);
+    (void)co_await c.exec<std::string>("GET", "rediscoro:keys:big");
+    for (int i = 0; i < 10; ++i) {
+      (void)co_await c.exec<rediscoro::ignore_t>("GET", "rediscoro:keys:hot");
     }
 
+    co_await c.close();
     ok = true;
     co_return;
   };
@@ -60,13 +1405,27 @@ TEST(client_test, exec_without_connect_is_rejected) {
   iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
   ctx.run();
 
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
   ASSERT_TRUE(ok) << diag;
+  auto const snap = tracker->snapshot();
+  EXPECT_EQ(snap.sampled, 12U);
+  ASSERT_FALSE(snap.hot_keys.empty());
+  EXPECT_EQ(snap.hot_keys.front().key, "rediscoro:keys:hot");
+  EXPECT_GE(snap.hot_keys.front().estimated_count, 10U);
+  ASSERT_FALSE(snap.big_keys.empty());
+  EXPECT_EQ(snap.big_keys.front().key, "rediscoro:keys:big");
+  EXPECT_EQ(snap.big_keys.front().command, "GET");
+  EXPECT_GT(snap.big_keys.front().reply_bytes, big.size());
 }
 
-TEST(client_test, resolve_timeout_zero_is_reported) {
+TEST(client_test, slow_request_log_records_requests_over_threshold) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
 
+  bool skipped = false;
+  std::string skip_reason{};
   bool ok = false;
   std::string diag{};
 
@@ -78,20 +1437,47 @@ TEST(client_test, resolve_timeout_zero_is_reported) {
     work_guard_reset reset{guard};
 
     rediscoro::config cfg{};
-    // Deterministic: resolve_timeout = 0ms makes with_timeout immediately time out.
-    cfg.host = "qq.com";
-    cfg.port = 80;
-    cfg.resolve_timeout = 0ms;
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
     cfg.reconnection.enabled = false;
+    cfg.slow_requests.enabled = true;
+    cfg.slow_requests.threshold = 0us;  // record everything
+    cfg.slow_requests.capacity = 2;
 
     rediscoro::client c{ctx.get_executor(), cfg};
     auto r = co_await c.connect();
-    if (r.has_value()) {
-      diag = "expected resolve_timeout, got success";
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
       co_return;
     }
-    if (r.error().code != rediscoro::client_errc::resolve_timeout) {
-      diag = "expected resolve_timeout, got: " + r.error().to_string();
+
+    (void)co_await c.exec<rediscoro::ignore_t>("PING");
+    (void)co_await c.exec<rediscoro::ignore_t>("SET", "rediscoro:slow", "v");
+    (void)co_await c.exec<std::string>("get", "rediscoro:slow");
+
+    auto const records = c.slow_requests();
+    co_await c.close();
+
+    if (records.size() != 2) {
+      diag = "expected the two most recent requests";
+      co_return;
+    }
+    if (records[0].command.view() != "SET" || records[1].command.view() != "GET") {
+      diag = "unexpected commands: " + std::string(records[0].command.view()) + ", " +
+             std::string(records[1].command.view());
+      co_return;
+    }
+    auto const& get = records[1];
+    using tp = rediscoro::slow_request_record::time_point;
+    if (get.written == tp{} || get.reply_read == tp{} || get.completed < get.written) {
+      diag = "phase timestamps missing";
+      co_return;
+    }
+    if (get.reply_bytes != 7 || get.generation != 1 || get.error) {
+      diag = "unexpected sizes, generation or error";
       co_return;
     }
 
@@ -102,13 +1488,18 @@ TEST(client_test, resolve_timeout_zero_is_reported) {
   iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
   ctx.run();
 
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
   ASSERT_TRUE(ok) << diag;
 }
 
-TEST(client_test, timeout_error_is_reported_for_unresponsive_peer) {
+TEST(client_test, slow_request_log_ignores_fast_requests) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
 
+  bool skipped = false;
+  std::string skip_reason{};
   bool ok = false;
   std::string diag{};
 
@@ -119,32 +1510,34 @@ TEST(client_test, timeout_error_is_reported_for_unresponsive_peer) {
     };
     work_guard_reset reset{guard};
 
+    // Only the slow-request log is on: nothing else stamps the submission time.
     rediscoro::config cfg{};
-    cfg.host = "10.255.255.1";
+    cfg.host = "127.0.0.1";
     cfg.port = 6379;
-    cfg.connect_timeout = 50ms;
-    cfg.resolve_timeout = 50ms;
-    cfg.request_timeout = 50ms;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
     cfg.reconnection.enabled = false;
+    cfg.slow_requests.enabled = true;
+    cfg.slow_requests.threshold = 50ms;
 
     rediscoro::client c{ctx.get_executor(), cfg};
     auto r = co_await c.connect();
-    if (r.has_value()) {
-      diag = "unexpected success connecting to blackhole address";
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
       co_return;
     }
 
-    auto const e = r.error();
+    for (int i = 0; i < 8; ++i) {
+      (void)co_await c.exec<rediscoro::ignore_t>("PING");
+    }
+    auto const records = c.slow_requests();
+    co_await c.close();
 
-    // Depending on routing, we may time out at TCP connect or during the handshake read/write.
-    if (!(e.code == rediscoro::client_errc::connect_timeout ||
-          e.code == rediscoro::client_errc::handshake_timeout ||
-          e.code == rediscoro::client_errc::connect_failed ||
-          e.code == rediscoro::client_errc::resolve_failed ||
-          e.code == rediscoro::client_errc::resolve_timeout ||
-          e.code == rediscoro::client_errc::connection_reset ||
-          e.code == rediscoro::client_errc::operation_aborted)) {
-      diag = "expected timeout/connect failure, got: " + e.to_string();
+    if (!records.empty()) {
+      diag = "fast requests recorded as slow: duration_us=" +
+             std::to_string(
+               std::chrono::duration_cast<std::chrono::microseconds>(records[0].duration).count());
       co_return;
     }
 
@@ -155,10 +1548,13 @@ TEST(client_test, timeout_error_is_reported_for_unresponsive_peer) {
   iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
   ctx.run();
 
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
   ASSERT_TRUE(ok) << diag;
 }
 
-TEST(client_test, connect_fails_with_queue_full_when_handshake_push_rejected) {
+TEST(client_test, health_check_pings_idle_connection) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
 
@@ -180,34 +1576,39 @@ TEST(client_test, connect_fails_with_queue_full_when_handshake_push_rejected) {
     cfg.resolve_timeout = 500ms;
     cfg.connect_timeout = 500ms;
     cfg.reconnection.enabled = false;
-    cfg.limits.pipeline.max_requests = 0;
-    cfg.limits.pipeline.max_pending_write_bytes = 0;
+    cfg.health_check.enabled = true;
+    cfg.health_check.interval = 20ms;
+    cfg.health_check.timeout = 1s;
 
     rediscoro::client c{ctx.get_executor(), cfg};
     auto r = co_await c.connect();
-    if (r.has_value()) {
-      diag = "expected queue_full on handshake enqueue, got success";
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
       co_return;
     }
 
-    if (r.error().code == rediscoro::client_errc::queue_full) {
-      ok = true;
+    co_await iocoro::co_sleep(150ms);
+    auto const s = c.stats();
+    auto resp = co_await c.exec<std::string>("PING");
+    co_await c.close();
+
+    if (s.health_checks == 0 || s.health_check_failures != 0) {
+      diag = "expected answered health checks, got checks=" + std::to_string(s.health_checks) +
+             " failures=" + std::to_string(s.health_check_failures);
       co_return;
     }
-
-    if (r.error().code == rediscoro::client_errc::resolve_timeout ||
-        r.error().code == rediscoro::client_errc::connect_timeout ||
-        r.error().code == rediscoro::client_errc::connect_failed ||
-        r.error().code == rediscoro::client_errc::resolve_failed ||
-        r.error().code == rediscoro::client_errc::connection_reset ||
-        r.error().code == rediscoro::client_errc::operation_aborted) {
-      skipped = true;
-      skip_reason =
-        "redis not available for handshake queue_full test (" + r.error().to_string() + ")";
+    if (s.ping_rtt_ewma_us >= 1'000'000 || s.disconnects != 0) {
+      diag = "unexpected round trip or disconnect";
+      co_return;
+    }
+    // The probe replies were consumed internally: user requests still line up with theirs.
+    if (!resp.get<0>() || *resp.get<0>() != "PONG") {
+      diag = "user PING did not get its own reply";
       co_return;
     }
 
-    diag = "expected queue_full, got: " + r.error().to_string();
+    ok = true;
     co_return;
   };
 
@@ -220,7 +1621,7 @@ TEST(client_test, connect_fails_with_queue_full_when_handshake_push_rejected) {
   ASSERT_TRUE(ok) << diag;
 }
 
-TEST(client_test, ping_set_get_roundtrip) {
+TEST(client_test, adaptive_timeout_keeps_healthy_requests_alive) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
 
@@ -242,6 +1643,9 @@ TEST(client_test, ping_set_get_roundtrip) {
     cfg.resolve_timeout = 500ms;
     cfg.connect_timeout = 500ms;
     cfg.reconnection.enabled = false;
+    cfg.adaptive_timeout.enabled = true;
+    cfg.adaptive_timeout.min_samples = 5;
+    cfg.adaptive_timeout.window = 30ms;
 
     rediscoro::client c{ctx.get_executor(), cfg};
     auto r = co_await c.connect();
@@ -251,55 +1655,101 @@ TEST(client_test, ping_set_get_roundtrip) {
       co_return;
     }
 
-    {
-      auto resp = co_await c.exec<std::string>("PING");
-      auto& slot = resp.get<0>();
-      if (!slot) {
-        diag = "PING failed: " + slot.error().to_string();
-        co_return;
-      }
-      if (*slot != "PONG") {
-        diag = "expected PONG, got: " + *slot;
-        co_return;
+    // First window measures; the requests after it run under the derived budget.
+    int failed = 0;
+    for (int round = 0; round < 2; ++round) {
+      for (int i = 0; i < 20; ++i) {
+        auto resp = co_await c.exec<std::string>("PING");
+        failed += resp.get<0>() ? 0 : 1;
       }
+      co_await iocoro::co_sleep(40ms);
     }
+    auto const s = c.stats();
+    co_await c.close();
 
-    const std::string key = "rediscoro:test:ping_set_get_roundtrip";
-    const std::string value = "42";
+    if (failed != 0 || s.timeouts != 0 || s.disconnects != 0) {
+      diag = "healthy requests failed: failed=" + std::to_string(failed) +
+             " timeouts=" + std::to_string(s.timeouts);
+      co_return;
+    }
 
-    {
-      auto resp = co_await c.exec<std::int64_t>("DEL", key);
-      auto& slot = resp.get<0>();
-      if (!slot) {
-        diag = "DEL failed: " + slot.error().to_string();
-        co_return;
-      }
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_test, exec_stream_yields_replies_in_order_under_backpressure) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.reconnection.enabled = false;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
     }
 
-    {
-      auto resp = co_await c.exec<std::string>("SET", key, value);
-      auto& slot = resp.get<0>();
-      if (!slot) {
-        diag = "SET failed: " + slot.error().to_string();
-        co_return;
-      }
-      if (*slot != "OK") {
-        diag = "expected OK from SET, got: " + *slot;
-        co_return;
-      }
+    constexpr int kReplies = 20000;
+    rediscoro::request req{};
+    for (int i = 0; i < kReplies; ++i) {
+      req.push("ECHO", std::to_string(i));
     }
 
-    {
-      auto resp = co_await c.exec<std::string>("GET", key);
-      auto& slot = resp.get<0>();
-      if (!slot) {
-        diag = "GET failed: " + slot.error().to_string();
-        co_return;
-      }
-      if (*slot != value) {
-        diag = "expected GET value " + value + ", got: " + *slot;
+    // A tiny buffer forces the reader to pause and resume many times.
+    auto stream = c.exec_stream<std::string>(std::move(req), 8);
+    if (stream.size() != static_cast<std::size_t>(kReplies)) {
+      diag = "unexpected stream size: " + std::to_string(stream.size());
+      co_return;
+    }
+    // Queued behind the stream: answered once the stream was drained.
+    auto after = iocoro::co_spawn(ctx.get_executor(), c.exec<std::string>("ECHO", "after"),
+                                  iocoro::use_awaitable);
+
+    int received = 0;
+    while (auto slot = co_await stream.next()) {
+      if (!*slot || **slot != std::to_string(received)) {
+        diag = "unexpected stream reply at index " + std::to_string(received);
         co_return;
       }
+      received += 1;
+    }
+    if (received != kReplies) {
+      diag = "stream ended early after " + std::to_string(received) + " replies";
+      co_return;
+    }
+
+    auto tail = co_await std::move(after);
+    if (!tail.get<0>() || *tail.get<0>() != "after") {
+      diag = "request queued behind the stream failed";
+      co_return;
     }
 
     co_await c.close();
@@ -558,3 +2008,79 @@ TEST(client_test, enqueue_exception_fallback_fails_sink_with_internal_error) {
 
   ASSERT_TRUE(ok) << diag;
 }
+
+TEST(client_test, adaptive_timeout_budget_tracks_observed_latency) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    // Only adaptive timeouts are on: nothing else stamps the submission time.
+    rediscoro::config cfg{};
+    cfg.host = "127.0.0.1";
+    cfg.port = 6379;
+    cfg.resolve_timeout = 500ms;
+    cfg.connect_timeout = 500ms;
+    cfg.request_timeout = 5000ms;
+    cfg.reconnection.enabled = false;
+    cfg.adaptive_timeout.enabled = true;
+    cfg.adaptive_timeout.multiplier = 4.0;
+    cfg.adaptive_timeout.min_timeout = 0ms;
+    cfg.adaptive_timeout.min_samples = 5;
+    cfg.adaptive_timeout.window = 200ms;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    // Warm up one window, then let the next PING close it.
+    auto slowest = std::chrono::steady_clock::duration::zero();
+    for (int i = 0; i < 20; ++i) {
+      auto const t0 = std::chrono::steady_clock::now();
+      (void)co_await c.exec<std::string>("PING");
+      slowest = std::max(slowest, std::chrono::steady_clock::now() - t0);
+    }
+    co_await iocoro::co_sleep(250ms);
+    (void)co_await c.exec<std::string>("PING");
+    auto const budget = co_await c.adaptive_timeout("ping");
+    co_await c.close();
+
+    if (!budget.has_value()) {
+      diag = "no budget derived after warm-up";
+      co_return;
+    }
+    // Within histogram precision of multiplier x the slowest observed round trip, and well
+    // below the 5s ceiling.
+    auto const limit = std::chrono::duration_cast<std::chrono::nanoseconds>(slowest) * 4 * 11 / 10;
+    if (*budget > limit || *budget >= 1s) {
+      diag = "budget " + std::to_string(budget->count()) + "ns exceeds 4 x slowest round trip (" +
+             std::to_string(limit.count()) + "ns)";
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
@@ -33,6 +33,7 @@ struct trace_recorder {
   mutable std::mutex mu;
   std::vector<rediscoro::request_trace_start> starts;
   std::vector<finish_snapshot> finishes;
+  std::vector<rediscoro::request_trace_phases> phases;
 
   static auto on_start(void* user_data, rediscoro::request_trace_start const& ev) -> void {
     auto* self = static_cast<trace_recorder*>(user_data);
@@ -54,6 +55,17 @@ struct trace_recorder {
     self->finishes.push_back(std::move(out));
   }
 
+  static auto on_phases(void* user_data, rediscoro::request_trace_phases const& ev) -> void {
+    auto* self = static_cast<trace_recorder*>(user_data);
+    std::lock_guard lock(self->mu);
+    self->phases.push_back(ev);
+  }
+
+  [[nodiscard]] auto phases_snapshot() const -> std::vector<rediscoro::request_trace_phases> {
+    std::lock_guard lock(mu);
+    return phases;
+  }
+
   [[nodiscard]] auto start_snapshot() const -> std::vector<rediscoro::request_trace_start> {
     std::lock_guard lock(mu);
     return starts;
@@ -225,6 +237,133 @@ TEST(client_trace_test, user_request_trace_finish_contains_primary_error_detail)
   ASSERT_TRUE(ok) << diag;
 }
 
+TEST(client_trace_test, phase_timestamps_cover_the_request_lifecycle) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  trace_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    auto cfg = make_cfg(&recorder);
+    cfg.trace_hooks.on_phases = &trace_recorder::on_phases;
+
+    rediscoro::client c{ctx.get_executor(), cfg};
+    auto cr = co_await connect_with_retry(c);
+    if (!cr) {
+      diag = "connect failed: " + cr.error().to_string();
+      co_return;
+    }
+
+    rediscoro::request req{};
+    req.push("PING");
+    req.push("ECHO", "x");
+    auto resp = co_await c.exec<std::string, std::string>(std::move(req));
+    if (!resp.get<0>() || !resp.get<1>()) {
+      diag = "PING/ECHO failed";
+      co_return;
+    }
+
+    co_await c.close();
+
+    auto phases = recorder.phases_snapshot();
+    auto finishes = recorder.finish_snapshot_copy();
+    if (phases.size() != 1 || finishes.size() != 1) {
+      diag = "expected exactly one phases event";
+      co_return;
+    }
+    auto const& p = phases[0];
+    if (p.info.id != finishes[0].info.id || p.info.command_count != 2) {
+      diag = "phases event does not match the request";
+      co_return;
+    }
+    using tp = rediscoro::request_trace_phases::time_point;
+    for (auto t : {p.enqueued, p.accepted, p.written, p.reply_read, p.parsed, p.adapted,
+                   p.resumed}) {
+      if (t == tp{}) {
+        diag = "phase timestamp not set";
+        co_return;
+      }
+    }
+    if (!(p.enqueued <= p.accepted && p.accepted <= p.written && p.written <= p.adapted &&
+          p.reply_read <= p.parsed && p.parsed <= p.adapted && p.adapted <= p.resumed)) {
+      diag = "phase timestamps out of order";
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(client_trace_test, sampling_traces_one_in_n_with_command_and_key) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  trace_recorder recorder{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    auto cfg = make_cfg(&recorder);
+    cfg.trace_hooks.sample_every = 2;
+    cfg.trace_hooks.capture_key = true;
+    cfg.trace_hooks.key_prefix_bytes = 4;
+
+    // Not connected: every request is rejected, which still reports start/finish when traced.
+    rediscoro::client c{ctx.get_executor(), cfg};
+    for (int i = 0; i < 4; ++i) {
+      (void)co_await c.exec<std::string>("get", "user:" + std::to_string(i));
+    }
+
+    auto starts = recorder.start_snapshot();
+    auto finishes = recorder.finish_snapshot_copy();
+    if (starts.size() != 2 || finishes.size() != 2) {
+      diag = "expected every second request to be traced";
+      co_return;
+    }
+    auto const& info = starts[0].info;
+    if (info.command.view() != "GET") {
+      diag = "command verb not recorded: " + std::string(info.command.view());
+      co_return;
+    }
+    if (info.key_hash != rediscoro::trace_key_hash("user:0") || info.key.view() != "user") {
+      diag = "first key not recorded";
+      co_return;
+    }
+    if (starts[1].info.key_hash != rediscoro::trace_key_hash("user:2")) {
+      diag = "unexpected sampled request";
+      co_return;
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
 TEST(client_trace_test, connect_close_without_user_request_emits_no_request_trace) {
   iocoro::io_context ctx;
   auto guard = iocoro::make_work_guard(ctx);
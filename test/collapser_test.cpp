@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/client.hpp>
+#include <rediscoro/collapser.hpp>
+#include <rediscoro/config.hpp>
+#include <rediscoro/error.hpp>
+
+#include <iocoro/iocoro.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct start_counter {
+  std::atomic<int> user_starts{0};
+  std::atomic<int> last_command_count{0};
+
+  static auto on_start(void* user_data, rediscoro::request_trace_start const& ev) -> void {
+    auto* self = static_cast<start_counter*>(user_data);
+    if (ev.info.kind != rediscoro::request_kind::user) {
+      return;
+    }
+    self->user_starts.fetch_add(1, std::memory_order_relaxed);
+    self->last_command_count.store(static_cast<int>(ev.info.command_count),
+                                   std::memory_order_relaxed);
+  }
+};
+
+auto make_config(start_counter* counter) -> rediscoro::config {
+  rediscoro::config cfg{};
+  cfg.host = "127.0.0.1";
+  cfg.port = 6379;
+  cfg.resolve_timeout = 500ms;
+  cfg.connect_timeout = 500ms;
+  cfg.reconnection.enabled = false;
+  if (counter != nullptr) {
+    cfg.trace_hooks = {
+      .user_data = counter,
+      .on_start = &start_counter::on_start,
+      .on_finish = nullptr,
+    };
+  }
+  return cfg;
+}
+
+}  // namespace
+
+TEST(collapser_test, reads_without_connect_are_rejected) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    rediscoro::client c{ctx.get_executor(), make_config(nullptr)};
+    rediscoro::collapser col{ctx.get_executor(), c};
+
+    auto a = iocoro::co_spawn(ctx.get_executor(), col.get("a"), iocoro::use_awaitable);
+    auto b = iocoro::co_spawn(ctx.get_executor(), col.hget("h", "f"), iocoro::use_awaitable);
+
+    for (auto* waiter : {&a, &b}) {
+      auto slot = co_await std::move(*waiter);
+      if (slot.has_value()) {
+        diag = "expected not_connected error, got value";
+        co_return;
+      }
+      if (slot.error().code != rediscoro::client_errc::not_connected) {
+        diag = "expected not_connected, got: " + slot.error().to_string();
+        co_return;
+      }
+    }
+
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(collapser_test, concurrent_gets_collapse_into_one_mget) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    start_counter counter{};
+    rediscoro::client c{ctx.get_executor(), make_config(&counter)};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    const std::string k1 = "rediscoro:test:collapser:k1";
+    const std::string k2 = "rediscoro:test:collapser:k2";
+    const std::string missing = "rediscoro:test:collapser:missing";
+    {
+      auto resp = co_await c.exec<std::string>("MSET", k1, "v1", k2, "v2");
+      if (!resp.get<0>()) {
+        diag = "MSET failed: " + resp.get<0>().error().to_string();
+        co_return;
+      }
+      auto del = co_await c.exec<std::int64_t>("DEL", missing);
+      if (!del.get<0>()) {
+        diag = "DEL failed: " + del.get<0>().error().to_string();
+        co_return;
+      }
+    }
+    counter.user_starts.store(0, std::memory_order_relaxed);
+
+    rediscoro::collapser col{ctx.get_executor(), c, {.window = 20ms}};
+
+    const std::vector<std::string> keys{k1, k2, k1, missing, k2, k1};
+    std::vector<iocoro::awaitable<rediscoro::response_slot<std::optional<std::string>>>> waiters{};
+    waiters.reserve(keys.size());
+    for (const auto& key : keys) {
+      waiters.push_back(iocoro::co_spawn(ctx.get_executor(), col.get(key), iocoro::use_awaitable));
+    }
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      auto slot = co_await std::move(waiters[i]);
+      if (!slot) {
+        diag = "collapsed GET failed: " + slot.error().to_string();
+        co_return;
+      }
+      const std::optional<std::string> expected =
+        keys[i] == k1 ? std::optional<std::string>{"v1"}
+                      : (keys[i] == k2 ? std::optional<std::string>{"v2"} : std::nullopt);
+      if (*slot != expected) {
+        diag = "unexpected value for " + keys[i];
+        co_return;
+      }
+    }
+
+    if (counter.user_starts.load(std::memory_order_relaxed) != 1) {
+      diag = "expected exactly one collapsed request, got " +
+             std::to_string(counter.user_starts.load(std::memory_order_relaxed));
+      co_return;
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
+
+TEST(collapser_test, concurrent_hgets_collapse_per_hash) {
+  iocoro::io_context ctx;
+  auto guard = iocoro::make_work_guard(ctx);
+
+  bool skipped = false;
+  std::string skip_reason{};
+  bool ok = false;
+  std::string diag{};
+
+  auto task = [&]() -> iocoro::awaitable<void> {
+    struct work_guard_reset {
+      decltype(guard)& g;
+      ~work_guard_reset() { g.reset(); }
+    };
+    work_guard_reset reset{guard};
+
+    start_counter counter{};
+    rediscoro::client c{ctx.get_executor(), make_config(&counter)};
+    auto r = co_await c.connect();
+    if (!r.has_value()) {
+      skipped = true;
+      skip_reason = "redis not available at 127.0.0.1:6379 (" + r.error().to_string() + ")";
+      co_return;
+    }
+
+    const std::string h1 = "rediscoro:test:collapser:h1";
+    const std::string h2 = "rediscoro:test:collapser:h2";
+    {
+      auto del = co_await c.exec<std::int64_t>("DEL", h1, h2);
+      auto set1 = co_await c.exec<std::int64_t>("HSET", h1, "a", "1", "b", "2");
+      auto set2 = co_await c.exec<std::int64_t>("HSET", h2, "a", "3");
+      if (!del.get<0>() || !set1.get<0>() || !set2.get<0>()) {
+        diag = "hash setup failed";
+        co_return;
+      }
+    }
+    counter.user_starts.store(0, std::memory_order_relaxed);
+
+    rediscoro::collapser col{ctx.get_executor(), c, {.window = 20ms}};
+
+    auto ex = ctx.get_executor();
+    auto h1a = iocoro::co_spawn(ex, col.hget(h1, "a"), iocoro::use_awaitable);
+    auto h1b = iocoro::co_spawn(ex, col.hget(h1, "b"), iocoro::use_awaitable);
+    auto h1z = iocoro::co_spawn(ex, col.hget(h1, "z"), iocoro::use_awaitable);
+    auto h2a = iocoro::co_spawn(ex, col.hget(h2, "a"), iocoro::use_awaitable);
+
+    auto v1a = co_await std::move(h1a);
+    auto v1b = co_await std::move(h1b);
+    auto v1z = co_await std::move(h1z);
+    auto v2a = co_await std::move(h2a);
+    if (!v1a || !v1b || !v1z || !v2a) {
+      diag = "collapsed HGET failed";
+      co_return;
+    }
+    if (*v1a != std::optional<std::string>{"1"} || *v1b != std::optional<std::string>{"2"} ||
+        v1z->has_value() || *v2a != std::optional<std::string>{"3"}) {
+      diag = "unexpected collapsed HGET values";
+      co_return;
+    }
+
+    // One HMGET per hash.
+    if (counter.user_starts.load(std::memory_order_relaxed) != 2) {
+      diag = "expected two collapsed requests, got " +
+             std::to_string(counter.user_starts.load(std::memory_order_relaxed));
+      co_return;
+    }
+
+    co_await c.close();
+    ok = true;
+    co_return;
+  };
+
+  iocoro::co_spawn(ctx.get_executor(), task(), iocoro::detached);
+  ctx.run();
+
+  if (skipped) {
+    GTEST_SKIP() << skip_reason;
+  }
+  ASSERT_TRUE(ok) << diag;
+}
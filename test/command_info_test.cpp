@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/command_info.hpp>
+#include <rediscoro/request.hpp>
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+using rediscoro::detail::all_commands_have;
+using rediscoro::detail::any_command_blocking;
+using rediscoro::detail::command_flags;
+using rediscoro::detail::first_command_argument;
+using rediscoro::detail::first_command_key;
+using rediscoro::detail::has_flag;
+using rediscoro::detail::lookup_command;
+using rediscoro::detail::next_command;
+
+TEST(command_info_test, lookup_is_case_insensitive) {
+  EXPECT_TRUE(has_flag(lookup_command("GET"), command_flags::read_only));
+  EXPECT_TRUE(has_flag(lookup_command("get"), command_flags::read_only));
+  EXPECT_TRUE(has_flag(lookup_command("hGetAll"), command_flags::read_only));
+}
+
+TEST(command_info_test, writes_and_unknown_commands_have_no_flags) {
+  EXPECT_EQ(lookup_command("SET"), command_flags::none);
+  EXPECT_EQ(lookup_command("INCR"), command_flags::none);
+  EXPECT_EQ(lookup_command("SRANDMEMBER"), command_flags::none);
+  EXPECT_EQ(lookup_command("NOT-A-COMMAND"), command_flags::none);
+  EXPECT_EQ(lookup_command(""), command_flags::none);
+  EXPECT_EQ(lookup_command(std::string_view{"GETXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX"}),
+            command_flags::none);
+}
+
+TEST(command_info_test, next_command_decodes_pipeline) {
+  rediscoro::request req;
+  req.push("GET", "k1");
+  req.push("HGET", "h", std::string_view{"f\r\n"});
+
+  std::vector<std::string_view> argv{};
+  std::size_t pos = 0;
+  ASSERT_TRUE(next_command(req.wire(), pos, argv));
+  ASSERT_EQ(argv.size(), 2u);
+  EXPECT_EQ(argv[0], "GET");
+  EXPECT_EQ(argv[1], "k1");
+
+  ASSERT_TRUE(next_command(req.wire(), pos, argv));
+  ASSERT_EQ(argv.size(), 3u);
+  EXPECT_EQ(argv[0], "HGET");
+  EXPECT_EQ(argv[2], "f\r\n");
+
+  EXPECT_EQ(pos, req.wire().size());
+  EXPECT_FALSE(next_command(req.wire(), pos, argv));
+}
+
+TEST(command_info_test, next_command_rejects_truncated_input) {
+  rediscoro::request req{"GET", "key"};
+  const std::string_view wire = req.wire();
+
+  std::vector<std::string_view> argv{};
+  std::size_t pos = 0;
+  EXPECT_FALSE(next_command(wire.substr(0, wire.size() - 3), pos, argv));
+}
+
+TEST(command_info_test, all_commands_have_requires_every_command) {
+  rediscoro::request reads;
+  reads.push("GET", "a");
+  reads.push("MGET", "a", "b");
+  EXPECT_TRUE(all_commands_have(reads.wire(), command_flags::read_only));
+
+  rediscoro::request mixed;
+  mixed.push("GET", "a");
+  mixed.push("SET", "a", "1");
+  EXPECT_FALSE(all_commands_have(mixed.wire(), command_flags::read_only));
+
+  EXPECT_FALSE(all_commands_have({}, command_flags::read_only));
+}
+
+TEST(command_info_test, blocking_commands_are_recognized) {
+  EXPECT_TRUE(any_command_blocking(rediscoro::request{"BLPOP", "q", "1"}.wire()));
+  // WAIT counts acknowledgements of its own connection's writes: never routed elsewhere.
+  EXPECT_FALSE(any_command_blocking(rediscoro::request{"wait", "1", "0"}.wire()));
+  EXPECT_FALSE(any_command_blocking(rediscoro::request{"WAITAOF", "1", "0", "0"}.wire()));
+  EXPECT_TRUE(has_flag(lookup_command("WAIT"), command_flags::connection_bound));
+  EXPECT_FALSE(any_command_blocking(rediscoro::request{"LPOP", "q"}.wire()));
+
+  rediscoro::request pipeline;
+  pipeline.push("SET", "a", "1");
+  pipeline.push("BRPOP", "q", "0");
+  EXPECT_TRUE(any_command_blocking(pipeline.wire()));
+}
+
+TEST(command_info_test, xread_blocks_only_with_block_option) {
+  rediscoro::request xread_block{"XREAD", "COUNT", "1", "BLOCK", "0", "STREAMS", "s", "$"};
+  EXPECT_TRUE(any_command_blocking(xread_block.wire()));
+  EXPECT_FALSE(any_command_blocking(rediscoro::request{"XREAD", "STREAMS", "s", "0"}.wire()));
+  // A stream named BLOCK is not the BLOCK option.
+  EXPECT_FALSE(any_command_blocking(rediscoro::request{"XREAD", "STREAMS", "BLOCK", "0"}.wire()));
+  rediscoro::request xreadgroup;
+  xreadgroup.push("XREADGROUP", "GROUP", "g", "c", "BLOCK", "10", "STREAMS", "s", ">");
+  EXPECT_TRUE(any_command_blocking(xreadgroup.wire()));
+}
+
+TEST(command_info_test, xreadgroup_names_and_option_values_are_not_keywords) {
+  // Group and consumer names follow GROUP; they are never options.
+  EXPECT_FALSE(any_command_blocking(
+    rediscoro::request{"XREADGROUP", "GROUP", "g", "BLOCK", "STREAMS", "s", ">"}.wire()));
+  EXPECT_TRUE(any_command_blocking(
+    rediscoro::request{"XREADGROUP", "GROUP", "STREAMS", "c", "BLOCK", "0", "STREAMS", "s", ">"}
+      .wire()));
+  // Neither is the value of COUNT.
+  EXPECT_TRUE(any_command_blocking(
+    rediscoro::request{"XREAD", "COUNT", "STREAMS", "BLOCK", "0", "STREAMS", "s", "$"}.wire()));
+  EXPECT_FALSE(any_command_blocking(
+    rediscoro::request{"XREADGROUP", "group", "g", "c", "NOACK", "STREAMS", "BLOCK", ">"}.wire()));
+}
+
+TEST(command_info_test, first_command_key_reads_first_argument) {
+  rediscoro::request req{"HGET", "user:1", "name"};
+  req.push("GET", "other");
+  EXPECT_EQ(first_command_key(req.wire()), "user:1");
+  EXPECT_EQ(first_command_key(rediscoro::request{"PING"}.wire()), "");
+  EXPECT_EQ(first_command_key(rediscoro::request{"GET", ""}.wire()), "");
+  EXPECT_EQ(first_command_key(""), "");
+  EXPECT_EQ(first_command_key("*2\r\n$3\r\nGET\r\n$5\r\nab"), "");
+}
+
+TEST(command_info_test, first_command_argument_walks_only_the_first_command) {
+  rediscoro::request req;
+  req.push("HSET", "h", "f", "v");
+  req.push("GET", "k");
+  EXPECT_EQ(first_command_argument(req.wire(), 0), "HSET");
+  EXPECT_EQ(first_command_argument(req.wire(), 2), "f");
+  EXPECT_EQ(first_command_argument(req.wire(), 3), "v");
+  EXPECT_EQ(first_command_argument(req.wire(), 4), "");  // not the next command's verb
+  EXPECT_EQ(first_command_argument("*2\r\n$3\r\nGET\r\n$5\r\nab", 1), "");
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/endpoint_cache.hpp>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using cache_t = rediscoro::detail::endpoint_cache<int>;
+
+TEST(endpoint_cache_test, empty_cache_misses) {
+  cache_t cache{1s, true};
+  EXPECT_FALSE(cache.lookup(cache_t::clock::now()).has_value());
+}
+
+TEST(endpoint_cache_test, entries_go_stale_after_ttl_but_are_still_served) {
+  cache_t cache{1s, true};
+  auto const t0 = cache_t::clock::now();
+  cache.store({1, 2}, t0);
+
+  auto fresh = cache.lookup(t0 + 500ms);
+  ASSERT_TRUE(fresh.has_value());
+  EXPECT_FALSE(fresh->stale);
+  EXPECT_EQ(fresh->endpoints, (std::vector<int>{1, 2}));
+
+  auto stale = cache.lookup(t0 + 1s);
+  ASSERT_TRUE(stale.has_value());
+  EXPECT_TRUE(stale->stale);
+  EXPECT_EQ(stale->endpoints, (std::vector<int>{1, 2}));
+
+  cache.store({3}, t0 + 2s);
+  auto refreshed = cache.lookup(t0 + 2s);
+  ASSERT_TRUE(refreshed.has_value());
+  EXPECT_FALSE(refreshed->stale);
+  EXPECT_EQ(refreshed->endpoints, (std::vector<int>{3}));
+}
+
+TEST(endpoint_cache_test, empty_store_keeps_previous_endpoints) {
+  cache_t cache{1s, true};
+  auto const t0 = cache_t::clock::now();
+  cache.store({1}, t0);
+  cache.store({}, t0);
+  ASSERT_TRUE(cache.lookup(t0).has_value());
+
+  cache.invalidate();
+  EXPECT_FALSE(cache.lookup(t0).has_value());
+}
+
+TEST(endpoint_cache_test, last_successful_endpoint_is_tried_first) {
+  cache_t cache{1s, true};
+  auto const t0 = cache_t::clock::now();
+  cache.store({1, 2, 3}, t0);
+  cache.remember_success(3);
+
+  EXPECT_EQ(cache.lookup(t0)->endpoints, (std::vector<int>{3, 1, 2}));
+  EXPECT_EQ(cache.order({4, 3}), (std::vector<int>{3, 4}));
+  EXPECT_EQ(cache.order({4, 5}), (std::vector<int>{4, 5}));
+
+  cache_t no_pref{1s, false};
+  no_pref.remember_success(2);
+  EXPECT_EQ(no_pref.order({1, 2}), (std::vector<int>{1, 2}));
+}
+
+TEST(endpoint_cache_test, only_one_refresh_at_a_time) {
+  cache_t cache{1s, true};
+  EXPECT_TRUE(cache.try_begin_refresh());
+  EXPECT_FALSE(cache.try_begin_refresh());
+  cache.end_refresh();
+  EXPECT_TRUE(cache.try_begin_refresh());
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/pending_response.hpp>
+#include <rediscoro/key_tracker.hpp>
+#include <rediscoro/request.hpp>
+#include <rediscoro/resp3/message.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using rediscoro::key_tracker;
+using rediscoro::key_tracker_options;
+
+TEST(key_tracker_test, sketch_never_underestimates) {
+  key_tracker tracker{key_tracker_options{.sketch_width = 64}};
+  for (int i = 0; i < 500; ++i) {
+    tracker.record("GET", "k" + std::to_string(i % 50), 10);
+  }
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_GE(tracker.estimate("k" + std::to_string(i)), 10U);
+  }
+}
+
+TEST(key_tracker_test, hot_keys_rank_most_accessed_first) {
+  key_tracker tracker{key_tracker_options{.top_k = 3}};
+  for (int round = 0; round < 100; ++round) {
+    tracker.record("GET", "hot", 4);
+    if (round % 2 == 0) {
+      tracker.record("GET", "warm", 4);
+    }
+    tracker.record("GET", "cold" + std::to_string(round), 4);
+  }
+
+  auto const snap = tracker.snapshot();
+  EXPECT_EQ(snap.sampled, 250U);
+  ASSERT_EQ(snap.hot_keys.size(), 3U);
+  EXPECT_EQ(snap.hot_keys[0].key, "hot");
+  EXPECT_GE(snap.hot_keys[0].estimated_count, 100U);
+  EXPECT_EQ(snap.hot_keys[1].key, "warm");
+  EXPECT_GE(snap.hot_keys[1].estimated_count, 50U);
+}
+
+TEST(key_tracker_test, big_keys_keep_largest_replies) {
+  key_tracker tracker{key_tracker_options{.top_k = 2}};
+  tracker.record("GET", "small", 10);
+  tracker.record("HGETALL", "large", 50'000);
+  tracker.record("GET", "medium", 1'000);
+  tracker.record("GET", "tiny", 1);
+  tracker.record("GET", "large", 20);  // smaller reply does not lower the recorded maximum
+
+  auto const snap = tracker.snapshot();
+  ASSERT_EQ(snap.big_keys.size(), 2U);
+  EXPECT_EQ(snap.big_keys[0].key, "large");
+  EXPECT_EQ(snap.big_keys[0].command, "HGETALL");
+  EXPECT_EQ(snap.big_keys[0].reply_bytes, 50'000U);
+  EXPECT_EQ(snap.big_keys[1].key, "medium");
+}
+
+TEST(key_tracker_test, command_reply_sizes_are_aggregated_per_verb) {
+  key_tracker tracker{};
+  tracker.record("get", "a", 10);
+  tracker.record("GET", "b", 30);
+  tracker.record("PING", "", 7);
+
+  auto const snap = tracker.snapshot();
+  ASSERT_EQ(snap.commands.size(), 2U);
+  EXPECT_EQ(snap.commands[0].command, "GET");
+  EXPECT_EQ(snap.commands[0].sampled, 2U);
+  EXPECT_EQ(snap.commands[0].reply_bytes, 40U);
+  EXPECT_EQ(snap.commands[0].max_reply_bytes, 30U);
+  EXPECT_EQ(snap.commands[1].command, "PING");
+  EXPECT_EQ(snap.hot_keys.size(), 2U);  // keyless commands are not tracked as keys
+}
+
+TEST(key_tracker_test, estimates_scale_with_sampling_and_reset_clears) {
+  key_tracker tracker{key_tracker_options{.sample_every = 10}};
+  for (int i = 0; i < 5; ++i) {
+    tracker.record("GET", "k", 1);
+  }
+  auto snap = tracker.snapshot();
+  ASSERT_EQ(snap.hot_keys.size(), 1U);
+  EXPECT_EQ(snap.hot_keys[0].estimated_count, 50U);
+
+  tracker.reset();
+  snap = tracker.snapshot();
+  EXPECT_EQ(snap.sampled, 0U);
+  EXPECT_TRUE(snap.hot_keys.empty());
+  EXPECT_TRUE(snap.big_keys.empty());
+  EXPECT_EQ(tracker.estimate("k"), 0U);
+}
+
+TEST(key_tracker_test, long_keys_are_truncated_in_reports) {
+  key_tracker tracker{key_tracker_options{.max_key_bytes = 4}};
+  tracker.record("GET", "user:12345", 1);
+  auto const snap = tracker.snapshot();
+  ASSERT_EQ(snap.hot_keys.size(), 1U);
+  EXPECT_EQ(snap.hot_keys[0].key, "user");
+  EXPECT_EQ(tracker.estimate("user:12345"), 1U);
+}
+
+TEST(key_tracker_test, concurrent_recording_counts_every_sample) {
+  key_tracker tracker{};
+  constexpr int threads = 4;
+  constexpr int per_thread = 5'000;
+  std::vector<std::thread> workers{};
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&tracker, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        tracker.record(t % 2 == 0 ? "GET" : "SET", "k" + std::to_string(i % 100), 8);
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  auto const snap = tracker.snapshot();
+  EXPECT_EQ(snap.sampled, static_cast<std::uint64_t>(threads * per_thread));
+  std::uint64_t total = 0;
+  for (auto const& c : snap.commands) {
+    total += c.sampled;
+  }
+  EXPECT_EQ(total, static_cast<std::uint64_t>(threads * per_thread));
+  EXPECT_GE(tracker.estimate("k0"), static_cast<std::uint64_t>(threads * per_thread / 100));
+}
+
+TEST(key_tracker_test, sink_reports_reply_bytes_on_completion) {
+  key_tracker tracker{};
+  rediscoro::request req{"GET", "session:1"};
+
+  auto sink = std::make_shared<rediscoro::detail::pending_dynamic_response<std::string>>(1);
+  sink->set_key_sample(rediscoro::detail::key_sample::from(&tracker, req.wire()));
+  sink->add_reply_bytes(123);
+  EXPECT_EQ(tracker.snapshot().sampled, 0U);
+
+  sink->deliver(rediscoro::resp3::message{rediscoro::resp3::bulk_string{"v"}});
+  auto const snap = tracker.snapshot();
+  EXPECT_EQ(snap.sampled, 1U);
+  ASSERT_EQ(snap.big_keys.size(), 1U);
+  EXPECT_EQ(snap.big_keys[0].key, "session:1");
+  EXPECT_EQ(snap.big_keys[0].command, "GET");
+  EXPECT_EQ(snap.big_keys[0].reply_bytes, 123U);
+  EXPECT_EQ(tracker.estimate("session:1"), 1U);
+}
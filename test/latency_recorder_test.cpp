@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/command_info.hpp>
+#include <rediscoro/detail/pending_response.hpp>
+#include <rediscoro/latency_recorder.hpp>
+#include <rediscoro/request.hpp>
+#include <rediscoro/resp3/message.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+using rediscoro::latency_histogram;
+using rediscoro::latency_recorder;
+
+TEST(latency_recorder_test, bucket_bounds_stay_within_relative_error) {
+  for (std::uint64_t v : {0ULL, 1ULL, 63ULL, 64ULL, 65ULL, 1000ULL, 123'456ULL, 9'999'999ULL,
+                          (1ULL << 35) + 17ULL}) {
+    auto const idx = latency_histogram::bucket_index(v);
+    ASSERT_LT(idx, latency_histogram::bucket_count);
+    auto const upper = latency_histogram::bucket_upper(idx);
+    EXPECT_GE(upper, v);
+    EXPECT_LE(static_cast<double>(upper - v), static_cast<double>(v) / 32.0 + 1.0) << v;
+    if (idx > 0) {
+      EXPECT_LT(latency_histogram::bucket_upper(idx - 1), v) << v;
+    }
+  }
+  // Values beyond the resolved range land in the top bucket.
+  EXPECT_EQ(latency_histogram::bucket_index(~0ULL), latency_histogram::bucket_count - 1);
+}
+
+TEST(latency_recorder_test, histogram_reports_percentiles) {
+  latency_histogram h{};
+  EXPECT_EQ(h.value_at_percentile(99.0), 0ns);
+
+  for (int i = 1; i <= 1000; ++i) {
+    h.record(std::chrono::microseconds{i});
+  }
+  auto const s = h.summary();
+  EXPECT_EQ(s.count, 1000U);
+  EXPECT_EQ(s.max, 1000us);
+
+  auto near = [](std::chrono::nanoseconds got, std::chrono::nanoseconds want) {
+    return got >= want && got.count() <= want.count() + want.count() / 32;
+  };
+  EXPECT_TRUE(near(s.p50, 500us)) << s.p50.count();
+  EXPECT_TRUE(near(s.p90, 900us)) << s.p90.count();
+  EXPECT_TRUE(near(s.p99, 990us)) << s.p99.count();
+  EXPECT_TRUE(near(s.p999, 999us)) << s.p999.count();
+  EXPECT_EQ(h.value_at_percentile(100.0), 1000us);
+}
+
+TEST(latency_recorder_test, histograms_merge) {
+  latency_histogram a{};
+  latency_histogram b{};
+  a.record(1ms);
+  b.record(5ms);
+  b.record(5ms);
+  a.merge(b);
+  EXPECT_EQ(a.count(), 3U);
+  EXPECT_EQ(a.max(), 5ms);
+  EXPECT_GE(a.value_at_percentile(50.0), 5ms);
+
+  a.reset();
+  EXPECT_EQ(a.count(), 0U);
+  EXPECT_EQ(a.max(), 0ns);
+}
+
+TEST(latency_recorder_test, recorder_groups_by_command_verb) {
+  latency_recorder rec{};
+  rec.record("get", 1ms);
+  rec.record("GET", 2ms);
+  rec.record("Set", 3ms);
+
+  ASSERT_NE(rec.find("GET"), nullptr);
+  EXPECT_EQ(rec.find("get")->count(), 2U);
+  ASSERT_NE(rec.find("SET"), nullptr);
+  EXPECT_EQ(rec.find("SET")->count(), 1U);
+  EXPECT_EQ(rec.find("DEL"), nullptr);
+  EXPECT_EQ(rec.overall().count(), 3U);
+
+  std::vector<std::string> verbs{};
+  rec.for_each_command([&](std::string_view verb, latency_histogram const&) {
+    verbs.emplace_back(verb);
+  });
+  std::ranges::sort(verbs);
+  EXPECT_EQ(verbs, (std::vector<std::string>{"GET", "SET"}));
+
+  latency_recorder other{};
+  other.record("DEL", 1ms);
+  other.record("GET", 1ms);
+  rec.merge(other);
+  EXPECT_EQ(rec.overall().count(), 5U);
+  EXPECT_EQ(rec.find("GET")->count(), 3U);
+  EXPECT_EQ(rec.find("DEL")->count(), 1U);
+}
+
+TEST(latency_recorder_test, recorder_memory_is_bounded) {
+  latency_recorder rec{};
+  for (std::size_t i = 0; i < latency_recorder::max_commands + 10; ++i) {
+    rec.record("CMD" + std::to_string(i), 1ms);
+  }
+  rec.record(std::string(latency_recorder::max_command_name + 1, 'X'), 1ms);
+  rec.record("", 1ms);
+
+  std::size_t commands = 0;
+  rec.for_each_command([&](std::string_view, latency_histogram const&) { commands += 1; });
+  EXPECT_EQ(commands, latency_recorder::max_commands);
+  EXPECT_EQ(rec.other().count(), 12U);
+  EXPECT_EQ(rec.overall().count(), latency_recorder::max_commands + 12);
+}
+
+TEST(latency_recorder_test, concurrent_recording_loses_no_samples) {
+  latency_recorder rec{};
+  constexpr int threads = 4;
+  constexpr int per_thread = 10'000;
+  std::vector<std::thread> workers{};
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&rec, t]() {
+      auto const verb = "V" + std::to_string(t % 2);
+      for (int i = 0; i < per_thread; ++i) {
+        rec.record(verb, std::chrono::nanoseconds{i});
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  EXPECT_EQ(rec.overall().count(), static_cast<std::uint64_t>(threads * per_thread));
+  EXPECT_EQ(rec.find("V0")->count(), static_cast<std::uint64_t>(2 * per_thread));
+  EXPECT_EQ(rec.find("V1")->count(), static_cast<std::uint64_t>(2 * per_thread));
+}
+
+TEST(latency_recorder_test, first_command_verb_reads_encoded_request) {
+  rediscoro::request req{"hget", "h", "f"};
+  req.push("GET", "k");
+  EXPECT_EQ(rediscoro::detail::first_command_verb(req.wire()), "hget");
+  EXPECT_EQ(rediscoro::detail::first_command_verb(""), "");
+  EXPECT_EQ(rediscoro::detail::first_command_verb("*1\r\n$3\r\nGE"), "");
+}
+
+TEST(latency_recorder_test, sink_records_latency_on_completion) {
+  latency_recorder rec{};
+  rediscoro::request req{"PING"};
+
+  auto sink = std::make_shared<rediscoro::detail::pending_dynamic_response<std::string>>(1);
+  sink->set_latency_target(rec.target_for(req.wire()), std::chrono::steady_clock::now() - 1ms);
+  EXPECT_EQ(rec.overall().count(), 0U);
+
+  sink->deliver(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+  EXPECT_EQ(rec.overall().count(), 1U);
+  ASSERT_NE(rec.find("PING"), nullptr);
+  EXPECT_EQ(rec.find("PING")->count(), 1U);
+  EXPECT_GE(rec.find("PING")->max(), 1ms);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+// Strip debug call sites in this translation unit.
+#define REDISCORO_LOG_MIN_LEVEL 1
+
+#include <rediscoro/async_log_sink.hpp>
+#include <rediscoro/logger.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct captured {
+  std::mutex mu{};
+  std::vector<std::string> messages{};
+  std::atomic<bool> gate{true};
+
+  static void fn(void* self, rediscoro::log_context const& ctx) {
+    auto* c = static_cast<captured*>(self);
+    while (!c->gate.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    std::lock_guard lock(c->mu);
+    c->messages.emplace_back(ctx.message);
+  }
+};
+
+}  // namespace
+
+TEST(logger_test, stripped_call_sites_do_not_evaluate_arguments) {
+  static_assert(rediscoro::compile_time_min_log_level == rediscoro::log_level::info);
+
+  captured out{};
+  auto& log = rediscoro::get_logger();
+  log.set_log_function(&captured::fn, &out);
+  log.set_log_level(rediscoro::log_level::debug);
+
+  int evaluated = 0;
+  REDISCORO_LOG_DEBUG("debug {}", ++evaluated);
+  REDISCORO_LOG_INFO("info {}", ++evaluated);
+  log.log(rediscoro::log_level::debug, "runtime debug", __FILE__, __LINE__);
+
+  log.set_log_function(nullptr);
+  log.set_log_level(rediscoro::log_level::off);
+
+  EXPECT_EQ(evaluated, 1);
+  EXPECT_EQ(out.messages, (std::vector<std::string>{"info 1"}));
+}
+
+TEST(logger_test, async_sink_delivers_records_from_many_threads) {
+  captured out{};
+  constexpr int threads = 4;
+  constexpr int per_thread = 500;
+  {
+    rediscoro::async_log_sink sink{threads * per_thread, &captured::fn, &out};
+    std::vector<std::thread> producers{};
+    for (int t = 0; t < threads; ++t) {
+      producers.emplace_back([&sink, t]() {
+        for (int i = 0; i < per_thread; ++i) {
+          auto const msg = std::to_string(t) + ":" + std::to_string(i);
+          ASSERT_TRUE(sink.push(rediscoro::log_context{.level = rediscoro::log_level::info,
+                                                       .message = msg,
+                                                       .file = __FILE__,
+                                                       .line = __LINE__,
+                                                       .timestamp = {}}));
+        }
+      });
+    }
+    for (auto& p : producers) {
+      p.join();
+    }
+    sink.flush();
+    EXPECT_EQ(sink.dropped(), 0u);
+  }
+
+  ASSERT_EQ(out.messages.size(), static_cast<std::size_t>(threads * per_thread));
+  // Per-producer order is preserved.
+  std::vector<int> next(threads, 0);
+  for (auto const& m : out.messages) {
+    auto const colon = m.find(':');
+    auto const t = std::stoi(m.substr(0, colon));
+    EXPECT_EQ(std::stoi(m.substr(colon + 1)), next[t]);
+    next[t] += 1;
+  }
+}
+
+TEST(logger_test, async_sink_drops_when_full_instead_of_blocking) {
+  captured out{};
+  out.gate.store(false);
+  {
+    rediscoro::async_log_sink sink{2, &captured::fn, &out};
+    for (int i = 0; i < 4; ++i) {
+      (void)sink.push(rediscoro::log_context{.level = rediscoro::log_level::error,
+                                             .message = std::to_string(i),
+                                             .file = __FILE__,
+                                             .line = __LINE__,
+                                             .timestamp = {}});
+    }
+    EXPECT_EQ(sink.dropped(), 2u);
+    out.gate.store(true);
+    sink.flush();
+  }
+  EXPECT_EQ(out.messages, (std::vector<std::string>{"0", "1"}));
+}
+
+TEST(logger_test, async_sink_installs_into_global_logger_and_truncates) {
+  captured out{};
+  auto& log = rediscoro::get_logger();
+  {
+    rediscoro::async_log_sink sink{16, &captured::fn, &out};
+    sink.install();
+    log.set_log_level(rediscoro::log_level::info);
+    REDISCORO_LOG_INFO("{}", std::string(1000, 'x'));
+    sink.flush();
+  }
+  log.set_log_level(rediscoro::log_level::off);
+
+  ASSERT_EQ(out.messages.size(), 1u);
+  EXPECT_EQ(out.messages[0], std::string(rediscoro::async_log_sink::max_message_size, 'x'));
+}
+
+TEST(logger_test, async_sink_keeps_log_function_installed_after_it) {
+  captured out{};
+  auto& log = rediscoro::get_logger();
+  {
+    rediscoro::async_log_sink sink{16};
+    sink.install();
+    log.set_log_function(&captured::fn, &out);
+  }
+  EXPECT_EQ(log.get_log_function(), &captured::fn);
+  EXPECT_EQ(log.get_log_user_data(), &out);
+
+  log.set_log_level(rediscoro::log_level::info);
+  REDISCORO_LOG_INFO("after");
+  log.set_log_level(rediscoro::log_level::off);
+  log.set_log_function(nullptr);
+  EXPECT_EQ(out.messages, (std::vector<std::string>{"after"}));
+}
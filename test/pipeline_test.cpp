@@ -2,6 +2,7 @@
 
 #include <rediscoro/detail/pipeline.hpp>
 #include <rediscoro/detail/response_sink.hpp>
+#include <rediscoro/detail/stream_sink.hpp>
 #include <rediscoro/error.hpp>
 #include <rediscoro/error_info.hpp>
 #include <rediscoro/request.hpp>
@@ -10,7 +11,9 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace {
 
@@ -138,6 +141,31 @@ TEST(pipeline_test, deadline_order_and_expiration) {
   EXPECT_TRUE(expired);
 }
 
+TEST(pipeline_test, last_deadline_reports_latest_queued_deadline) {
+  rediscoro::detail::pipeline p;
+  EXPECT_EQ(p.last_deadline(), rediscoro::detail::pipeline::time_point::min());
+
+  rediscoro::request req1{"PING"};
+  rediscoro::request req2{"PING"};
+  rediscoro::request req3{"PING"};
+  auto const now = rediscoro::detail::pipeline::clock::now();
+  auto const d1 = now + std::chrono::milliseconds(200);
+  auto const d2 = now + std::chrono::milliseconds(100);
+
+  ASSERT_TRUE(p.push(req1, std::make_shared<counting_sink>(1), d1));
+  p.on_write_done(req1.wire().size());  // req1 now awaits its reply
+  EXPECT_EQ(p.last_deadline(), d1);
+
+  ASSERT_TRUE(p.push(req2, std::make_shared<counting_sink>(1), d2));
+  EXPECT_EQ(p.last_deadline(), d1);  // latest of the queue backs
+
+  // Requests without a deadline do not constrain later ones.
+  ASSERT_TRUE(p.push(req3, std::make_shared<counting_sink>(1)));
+  p.on_write_done(req2.wire().size());
+  p.on_write_done(req3.wire().size());
+  EXPECT_EQ(p.last_deadline(), rediscoro::detail::pipeline::time_point::min());
+}
+
 TEST(pipeline_test, clear_all_mixed_pending_and_awaiting) {
   rediscoro::detail::pipeline p;
 
@@ -182,6 +210,27 @@ TEST(pipeline_test, request_limit_rejects_push) {
   EXPECT_EQ(p.pending_count(), 1u);
 }
 
+TEST(pipeline_test, internal_push_ignores_limits_filled_by_deferred_requests) {
+  rediscoro::detail::pipeline p{rediscoro::detail::pipeline::limits{
+    .max_requests = 2,
+    .max_pending_write_bytes = 1024,
+  }};
+  rediscoro::request req{"PING"};
+  auto const never = rediscoro::detail::pipeline::time_point::max();
+
+  ASSERT_TRUE(p.defer(req, std::make_shared<counting_sink>(1), never));
+  ASSERT_TRUE(p.defer(req, std::make_shared<counting_sink>(1), never));
+  EXPECT_FALSE(p.push(req, std::make_shared<counting_sink>(1)));
+
+  // The handshake still goes out, ahead of the deferred requests.
+  rediscoro::request hello{"HELLO", "3"};
+  auto handshake = std::make_shared<counting_sink>(1);
+  p.push_internal(hello, handshake);
+  EXPECT_EQ(p.pending_count(), 3u);
+  ASSERT_TRUE(p.has_pending_write());
+  EXPECT_EQ(p.next_write_buffer(), hello.wire());
+}
+
 TEST(pipeline_test, pending_write_bytes_limit_rejects_push) {
   rediscoro::request req{"PING"};
   const auto max_bytes = req.wire().size();
@@ -240,3 +289,338 @@ TEST(pipeline_test, pending_write_bytes_reclaimed_after_write_done_and_clear_all
     EXPECT_TRUE(p.push(req, s2));
   }
 }
+
+TEST(pipeline_test, coalesced_write_spans_multiple_requests) {
+  rediscoro::detail::pipeline p{rediscoro::detail::pipeline::limits{},
+                                rediscoro::detail::pipeline::write_options{.coalesce = true}};
+
+  rediscoro::request req1{"GET", "a"};
+  rediscoro::request req2{"GET", "b"};
+  rediscoro::request req3{"GET", "c"};
+  auto s1 = std::make_shared<counting_sink>(1);
+  auto s2 = std::make_shared<counting_sink>(1);
+  auto s3 = std::make_shared<counting_sink>(1);
+
+  ASSERT_TRUE(p.push(req1, s1));
+  ASSERT_TRUE(p.push(req2, s2));
+  ASSERT_TRUE(p.push(req3, s3));
+
+  const auto all = req1.wire() + req2.wire() + req3.wire();
+  auto b1 = p.next_write_buffer();
+  EXPECT_EQ(b1, all);
+
+  // Partial write ending in the middle of req2: req1 completes, req2 stays pending.
+  const auto first = req1.wire().size() + 2;
+  p.on_write_done(first);
+  EXPECT_TRUE(p.has_pending_read());
+  EXPECT_TRUE(p.has_pending_write());
+  EXPECT_EQ(p.pending_write_bytes(), all.size() - first);
+
+  // Continue from the same coalesced buffer.
+  auto b2 = p.next_write_buffer();
+  EXPECT_EQ(b2, std::string_view{all}.substr(first));
+
+  p.on_write_done(b2.size());
+  EXPECT_FALSE(p.has_pending_write());
+  EXPECT_EQ(p.pending_write_bytes(), 0u);
+
+  // Each request still owns its own reply slot (FIFO).
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"1"}});
+  EXPECT_TRUE(s1->is_complete());
+  EXPECT_FALSE(s2->is_complete());
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"2"}});
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"3"}});
+  EXPECT_TRUE(s2->is_complete());
+  EXPECT_TRUE(s3->is_complete());
+  EXPECT_FALSE(p.has_pending_read());
+}
+
+TEST(pipeline_test, coalesced_write_respects_batch_limits) {
+  rediscoro::request req{"PING"};
+  const auto wire = req.wire();
+
+  rediscoro::detail::pipeline p{rediscoro::detail::pipeline::limits{},
+                                rediscoro::detail::pipeline::write_options{
+                                  .coalesce = true,
+                                  .max_batch_bytes = 64U * 1024U,
+                                  .max_batch_requests = 2,
+                                }};
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(p.push(req, std::make_shared<counting_sink>(1)));
+  }
+
+  auto b1 = p.next_write_buffer();
+  EXPECT_EQ(b1.size(), wire.size() * 2);
+  p.on_write_done(b1.size());
+
+  // Only one request left: zero-copy path.
+  auto b2 = p.next_write_buffer();
+  EXPECT_EQ(b2, wire);
+  p.on_write_done(b2.size());
+  EXPECT_FALSE(p.has_pending_write());
+}
+
+TEST(pipeline_test, clear_all_discards_coalesced_write_buffer) {
+  rediscoro::detail::pipeline p{rediscoro::detail::pipeline::limits{},
+                                rediscoro::detail::pipeline::write_options{.coalesce = true}};
+
+  rediscoro::request req{"PING"};
+  auto s1 = std::make_shared<counting_sink>(1);
+  auto s2 = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.push(req, s1));
+  ASSERT_TRUE(p.push(req, s2));
+
+  auto b1 = p.next_write_buffer();
+  ASSERT_EQ(b1.size(), req.wire().size() * 2);
+  p.on_write_done(1);
+
+  p.clear_all(rediscoro::client_errc::connection_closed);
+  EXPECT_EQ(s1->err_count(), 1u);
+  EXPECT_EQ(s2->err_count(), 1u);
+
+  // A fresh request starts from its own wire bytes, not from the discarded batch.
+  auto s3 = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.push(req, s3));
+  EXPECT_EQ(p.next_write_buffer(), req.wire());
+}
+
+TEST(pipeline_test, deferred_requests_are_written_after_later_pushes) {
+  rediscoro::detail::pipeline p;
+
+  rediscoro::request user{"GET", "k"};
+  rediscoro::request handshake{"HELLO", "3"};
+  auto user_sink = std::make_shared<counting_sink>(1);
+  auto handshake_sink = std::make_shared<counting_sink>(1);
+
+  ASSERT_TRUE(p.defer(user, user_sink, rediscoro::detail::pipeline::time_point::max()));
+  EXPECT_TRUE(p.has_deferred());
+  EXPECT_FALSE(p.has_pending_write());
+  EXPECT_EQ(p.pending_count(), 1u);
+  EXPECT_EQ(p.pending_write_bytes(), user.wire().size());
+
+  ASSERT_TRUE(p.push(handshake, handshake_sink));
+  p.release_deferred();
+  EXPECT_FALSE(p.has_deferred());
+
+  // The handshake goes first even though the user request was submitted earlier.
+  EXPECT_EQ(p.next_write_buffer(), handshake.wire());
+  p.on_write_done(handshake.wire().size());
+  EXPECT_EQ(p.next_write_buffer(), user.wire());
+  p.on_write_done(user.wire().size());
+
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"OK"}});
+  EXPECT_EQ(handshake_sink->msg_count(), 1u);
+  EXPECT_EQ(user_sink->msg_count(), 0u);
+}
+
+TEST(pipeline_test, deferred_requests_count_towards_limits_and_fail_on_clear_all) {
+  rediscoro::detail::pipeline p{rediscoro::detail::pipeline::limits{.max_requests = 1}};
+
+  rediscoro::request req{"PING"};
+  auto s1 = std::make_shared<counting_sink>(1);
+  auto s2 = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.defer(req, s1, rediscoro::detail::pipeline::time_point::max()));
+  EXPECT_FALSE(p.push(req, s2));
+
+  p.clear_all(rediscoro::client_errc::handshake_failed);
+  EXPECT_EQ(s1->err_count(), 1u);
+  EXPECT_FALSE(p.has_deferred());
+  EXPECT_EQ(p.pending_write_bytes(), 0u);
+}
+
+TEST(pipeline_test, park_keeps_unwritten_and_replayable_requests_in_order) {
+  using rediscoro::detail::pipeline;
+  pipeline p;
+
+  rediscoro::request get{"GET", "k"};
+  rediscoro::request set{"SET", "k", "v"};
+  auto written_get = std::make_shared<counting_sink>(1);
+  auto written_set = std::make_shared<counting_sink>(1);
+  auto unwritten_set = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.push(get, written_get, pipeline::time_point::max(), true));
+  ASSERT_TRUE(p.push(set, written_set, pipeline::time_point::max()));
+  ASSERT_TRUE(p.push(set, unwritten_set, pipeline::time_point::max()));
+
+  // GET and the first SET are written; the second SET is only partially written.
+  p.on_write_done(get.wire().size());
+  p.on_write_done(set.wire().size());
+  p.on_write_done(1);
+  ASSERT_TRUE(p.has_pending_read());
+
+  auto const parked = p.park(rediscoro::client_errc::connection_lost, 16, 1024);
+  EXPECT_EQ(parked, 2u);
+  EXPECT_EQ(written_set->err_count(), 1u);  // may have run on the server: never resent
+  EXPECT_EQ(written_get->err_count(), 0u);
+  EXPECT_EQ(unwritten_set->err_count(), 0u);
+  EXPECT_FALSE(p.has_pending_read());
+  EXPECT_FALSE(p.has_pending_write());
+  EXPECT_EQ(p.deferred_bytes(), get.wire().size() + set.wire().size());
+  EXPECT_EQ(p.pending_write_bytes(), p.deferred_bytes());
+
+  // Replayed from the first byte, in the original order.
+  p.release_deferred();
+  EXPECT_EQ(p.next_write_buffer(), get.wire());
+  p.on_write_done(get.wire().size());
+  EXPECT_EQ(p.next_write_buffer(), set.wire());
+}
+
+TEST(pipeline_test, fail_awaiting_keeps_written_replayable_requests_from_park) {
+  using rediscoro::detail::pipeline;
+  pipeline p;
+
+  rediscoro::request get{"GET", "k"};
+  auto written = std::make_shared<counting_sink>(1);
+  auto unwritten = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.push(get, written, pipeline::time_point::max(), true));
+  ASSERT_TRUE(p.push(get, unwritten, pipeline::time_point::max(), true));
+  p.on_write_done(get.wire().size());
+
+  EXPECT_EQ(p.fail_awaiting(rediscoro::client_errc::outcome_unknown), 1u);
+  EXPECT_EQ(written->err_count(), 1u);
+  EXPECT_FALSE(p.has_pending_read());
+
+  EXPECT_EQ(p.park(rediscoro::client_errc::connection_lost, 16, 1024), 1u);
+  EXPECT_EQ(unwritten->err_count(), 0u);
+}
+
+TEST(pipeline_test, park_fails_internal_requests_instead_of_replaying_them) {
+  using rediscoro::detail::pipeline;
+  pipeline p;
+
+  // A reconnect: a buffered user request behind a handshake whose write failed midway.
+  rediscoro::request get{"GET", "k"};
+  auto user = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.defer(get, user, pipeline::time_point::max(), true));
+  rediscoro::request hello{"HELLO", "3"};
+  auto handshake = std::make_shared<counting_sink>(1);
+  p.push_internal(hello, handshake);
+  p.on_write_done(1);
+
+  EXPECT_EQ(p.park(rediscoro::client_errc::connection_lost, 16, 1024), 1u);
+  EXPECT_EQ(handshake->err_count(), 1u);
+  EXPECT_EQ(user->err_count(), 0u);
+  EXPECT_EQ(p.deferred_bytes(), get.wire().size());
+
+  // A written, unanswered health-check PING is not replayed either.
+  p.release_deferred();
+  p.on_write_done(get.wire().size());
+  rediscoro::request ping{"PING"};
+  auto probe = std::make_shared<counting_sink>(1);
+  p.push_internal(ping, probe);
+  p.on_write_done(ping.wire().size());
+
+  EXPECT_EQ(p.park(rediscoro::client_errc::connection_lost, 16, 1024), 1u);
+  EXPECT_EQ(probe->err_count(), 1u);
+  p.release_deferred();
+  EXPECT_EQ(p.next_write_buffer(), get.wire());
+}
+
+TEST(pipeline_test, park_respects_bounds_and_skips_partially_answered_requests) {
+  using rediscoro::detail::pipeline;
+  pipeline p;
+
+  rediscoro::request two;
+  two.push("GET", "a");
+  two.push("GET", "b");
+  rediscoro::request one{"GET", "c"};
+  auto partial = std::make_shared<counting_sink>(2);
+  auto s1 = std::make_shared<counting_sink>(1);
+  auto s2 = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.push(two, partial, pipeline::time_point::max(), true));
+  ASSERT_TRUE(p.push(one, s1, pipeline::time_point::max(), true));
+  ASSERT_TRUE(p.push(one, s2, pipeline::time_point::max(), true));
+  p.on_write_done(two.wire().size());
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"x"}});
+
+  auto const parked = p.park(rediscoro::client_errc::connection_lost, 1, 1024);
+  EXPECT_EQ(parked, 1u);
+  EXPECT_EQ(partial->msg_count(), 1u);
+  EXPECT_EQ(partial->err_count(), 1u);
+  EXPECT_EQ(s1->err_count(), 0u);
+  EXPECT_EQ(s2->err_count(), 1u);  // over max_requests
+}
+
+TEST(pipeline_test, fail_expired_deferred_fails_only_elapsed_requests) {
+  using rediscoro::detail::pipeline;
+  pipeline p;
+
+  auto const now = pipeline::clock::now();
+  rediscoro::request req{"PING"};
+  auto early = std::make_shared<counting_sink>(1);
+  auto late = std::make_shared<counting_sink>(1);
+  ASSERT_TRUE(p.defer(req, early, now - std::chrono::milliseconds{1}));
+  ASSERT_TRUE(p.defer(req, late, now + std::chrono::hours{1}));
+
+  EXPECT_EQ(p.fail_expired_deferred(now, rediscoro::client_errc::request_timeout), 1u);
+  EXPECT_EQ(early->err_count(), 1u);
+  EXPECT_EQ(late->err_count(), 0u);
+  EXPECT_EQ(p.deferred_count(), 1u);
+  EXPECT_EQ(p.deferred_bytes(), req.wire().size());
+  EXPECT_EQ(p.next_deadline(), now + std::chrono::hours{1});
+}
+
+TEST(pipeline_test, saturated_stream_sink_pauses_reads_until_abandoned) {
+  rediscoro::detail::pipeline p;
+
+  rediscoro::request req;
+  for (int i = 0; i < 4; ++i) {
+    req.push("PING");
+  }
+  auto stream = std::make_shared<rediscoro::detail::stream_sink<std::string>>(4, 2);
+  int resumed = 0;
+  stream->set_resume_reader([&resumed]() { resumed += 1; });
+  ASSERT_TRUE(p.push(req, stream));
+  p.on_write_done(req.wire().size());
+
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+  EXPECT_FALSE(p.read_paused());
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+  EXPECT_TRUE(p.read_paused());  // two unconsumed replies buffered
+
+  // A consumer that goes away must never leave the reader paused.
+  stream->abandon();
+  EXPECT_EQ(resumed, 1);
+  EXPECT_FALSE(p.read_paused());
+
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+  EXPECT_TRUE(stream->is_complete());
+  EXPECT_FALSE(p.has_pending_read());
+  EXPECT_FALSE(p.read_paused());
+}
+
+TEST(pipeline_test, phase_stamping_records_write_and_reply_times) {
+  std::vector<rediscoro::request_trace_phases> seen{};
+  rediscoro::request_trace_hooks hooks{
+    .user_data = &seen,
+    .on_phases =
+      [](void* user_data, rediscoro::request_trace_phases const& ev) {
+        static_cast<std::vector<rediscoro::request_trace_phases>*>(user_data)->push_back(ev);
+      },
+  };
+
+  rediscoro::detail::pipeline p;
+  p.set_phase_stamping(true);
+
+  rediscoro::request req{"PING"};
+  auto stream = std::make_shared<rediscoro::detail::stream_sink<std::string>>(1, 8);
+  auto const start = std::chrono::steady_clock::now();
+  stream->set_trace_context(hooks, rediscoro::request_trace_info{.id = 7}, start, start);
+  ASSERT_TRUE(p.push(req, stream));
+  p.on_write_done(req.wire().size());
+
+  auto const read_at = std::chrono::steady_clock::now();
+  p.stamp_reply(read_at, read_at + std::chrono::microseconds(1));
+  p.on_message(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+
+  ASSERT_EQ(seen.size(), 1U);
+  auto const& ev = seen[0];
+  EXPECT_EQ(ev.info.id, 7U);
+  EXPECT_EQ(ev.enqueued, start);
+  EXPECT_GE(ev.written, start);
+  EXPECT_EQ(ev.reply_read, read_at);
+  EXPECT_EQ(ev.parsed, read_at + std::chrono::microseconds(1));
+  EXPECT_GE(ev.adapted, ev.written);
+  EXPECT_EQ(ev.resumed, rediscoro::request_trace_phases::time_point{});  // streams have no waiter
+}
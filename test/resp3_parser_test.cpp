@@ -232,6 +232,28 @@ TEST(resp3_parser_test, parse_multiple_messages_from_one_feed) {
   EXPECT_FALSE(r3->has_value());
 }
 
+TEST(resp3_parser_test, message_bytes_reports_wire_size_of_each_message) {
+  parser p;
+  append(p, "*1\r\n$3\r\nfoo\r\n");
+  append(p, ":4");  // second message split across feeds
+
+  auto r1 = p.parse_one();
+  ASSERT_TRUE(r1);
+  ASSERT_TRUE(r1->has_value());
+  EXPECT_EQ(p.message_bytes(), 4U + 9U);
+  p.reclaim();
+
+  auto r2 = p.parse_one();
+  ASSERT_TRUE(r2);
+  EXPECT_FALSE(r2->has_value());
+  append(p, "2\r\n");
+  r2 = p.parse_one();
+  ASSERT_TRUE(r2);
+  ASSERT_TRUE(r2->has_value());
+  EXPECT_EQ(p.message_bytes(), 5U);
+  p.reclaim();
+}
+
 TEST(resp3_parser_test, protocol_error_marks_failed) {
   parser p;
   append(p, "?oops\r\n");
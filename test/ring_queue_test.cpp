@@ -86,3 +86,25 @@ TEST(ring_queue_test, move_assign_from_other_preserves_order) {
   b.pop_front();
   EXPECT_TRUE(b.empty());
 }
+
+TEST(ring_queue_test, indexed_access_follows_fifo_order_after_wraparound) {
+  rediscoro::detail::ring_queue<int> q;
+
+  for (int i = 0; i < 8; ++i) {
+    q.push_back(i);
+  }
+  for (int i = 0; i < 5; ++i) {
+    q.pop_front();
+  }
+  for (int i = 8; i < 12; ++i) {
+    q.push_back(i);
+  }
+
+  ASSERT_EQ(q.size(), 7u);
+  for (std::size_t i = 0; i < q.size(); ++i) {
+    EXPECT_EQ(q.at(i), static_cast<int>(i) + 5);
+  }
+
+  q.at(0) = 42;
+  EXPECT_EQ(q.front(), 42);
+}
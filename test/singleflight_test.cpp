@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/pipeline.hpp>
+#include <rediscoro/detail/response_sink.hpp>
+#include <rediscoro/detail/singleflight.hpp>
+#include <rediscoro/error.hpp>
+#include <rediscoro/error_info.hpp>
+#include <rediscoro/request.hpp>
+#include <rediscoro/resp3/message.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+
+class recording_sink final : public rediscoro::detail::response_sink {
+ public:
+  explicit recording_sink(std::size_t n) : expected_(n) {}
+
+  [[nodiscard]] auto expected_replies() const noexcept -> std::size_t override { return expected_; }
+
+  [[nodiscard]] auto is_complete() const noexcept -> bool override {
+    return (msgs_ + errs_) == expected_;
+  }
+
+  [[nodiscard]] auto msg_count() const noexcept -> std::size_t { return msgs_; }
+  [[nodiscard]] auto err_count() const noexcept -> std::size_t { return errs_; }
+  [[nodiscard]] auto last_value() const -> std::string const& { return last_value_; }
+
+  [[nodiscard]] auto saturated() const noexcept -> bool override { return saturated_; }
+  auto set_saturated(bool v) noexcept -> void { saturated_ = v; }
+
+ protected:
+  auto do_deliver(rediscoro::resp3::message msg) -> void override {
+    msgs_ += 1;
+    if (auto* s = msg.try_as<rediscoro::resp3::simple_string>()) {
+      last_value_ = std::string{s->data};
+    }
+  }
+  auto do_deliver_error(rediscoro::error_info) -> void override { errs_ += 1; }
+
+ private:
+  std::size_t expected_{0};
+  std::size_t msgs_{0};
+  std::size_t errs_{0};
+  std::string last_value_{};
+  bool saturated_{false};
+};
+
+auto simple(std::string_view s) -> rediscoro::resp3::message {
+  return rediscoro::resp3::message{rediscoro::resp3::simple_string{s}};
+}
+
+}  // namespace
+
+TEST(singleflight_test, followers_receive_copies_of_leader_reply) {
+  rediscoro::detail::singleflight_group group;
+  rediscoro::request req{"GET", "k"};
+
+  auto leader = std::make_shared<recording_sink>(1);
+  auto follower = std::make_shared<recording_sink>(1);
+
+  EXPECT_FALSE(group.try_join(req.wire(), leader));
+  auto flight = group.lead(req.wire(), leader);
+  ASSERT_NE(flight, nullptr);
+  EXPECT_TRUE(group.try_join(req.wire(), follower));
+  EXPECT_EQ(flight->follower_count(), 1u);
+
+  flight->deliver(simple("v"));
+  EXPECT_TRUE(flight->is_complete());
+  EXPECT_EQ(leader->msg_count(), 1u);
+  EXPECT_EQ(follower->msg_count(), 1u);
+  EXPECT_EQ(leader->last_value(), "v");
+  EXPECT_EQ(follower->last_value(), "v");
+  EXPECT_EQ(group.size(), 0u);
+}
+
+TEST(singleflight_test, backpressure_of_any_sharer_pauses_the_shared_read) {
+  rediscoro::detail::singleflight_group group;
+  rediscoro::detail::pipeline pipeline;
+  rediscoro::request req{"LRANGE", "l", "0", "-1"};
+  req.push("LRANGE", "l", "0", "-1");
+
+  // Two stream consumers of the same read: the follower lags behind.
+  auto leader = std::make_shared<recording_sink>(2);
+  auto follower = std::make_shared<recording_sink>(2);
+  auto flight = group.lead(req.wire(), leader);
+  ASSERT_NE(flight, nullptr);
+  ASSERT_TRUE(group.try_join(req.wire(), follower));
+  ASSERT_TRUE(pipeline.push(std::move(req), flight));
+  auto const wire = pipeline.next_write_buffer();
+  pipeline.on_write_done(wire.size());
+
+  EXPECT_FALSE(pipeline.read_paused());
+  follower->set_saturated(true);
+  EXPECT_TRUE(flight->saturated());
+  EXPECT_TRUE(pipeline.read_paused());
+
+  follower->set_saturated(false);
+  EXPECT_FALSE(pipeline.read_paused());
+  pipeline.on_message(simple("a"));
+  pipeline.on_message(simple("b"));
+  EXPECT_EQ(leader->msg_count(), 2u);
+  EXPECT_EQ(follower->msg_count(), 2u);
+}
+
+TEST(singleflight_test, no_join_after_first_reply_of_multi_reply_request) {
+  rediscoro::detail::singleflight_group group;
+  rediscoro::request req;
+  req.push("GET", "a");
+  req.push("GET", "b");
+
+  auto leader = std::make_shared<recording_sink>(2);
+  auto flight = group.lead(req.wire(), leader);
+  ASSERT_NE(flight, nullptr);
+
+  flight->deliver(simple("a"));
+  auto late = std::make_shared<recording_sink>(2);
+  EXPECT_FALSE(group.try_join(req.wire(), late));
+
+  flight->deliver(simple("b"));
+  EXPECT_TRUE(leader->is_complete());
+}
+
+TEST(singleflight_test, pipeline_errors_fan_out_to_followers) {
+  rediscoro::detail::singleflight_group group;
+  rediscoro::detail::pipeline p;
+  rediscoro::request req{"GET", "k"};
+
+  auto leader = std::make_shared<recording_sink>(1);
+  auto follower = std::make_shared<recording_sink>(1);
+  auto flight = group.lead(req.wire(), leader);
+  ASSERT_NE(flight, nullptr);
+  ASSERT_TRUE(p.push(req, flight));
+  ASSERT_TRUE(group.try_join(req.wire(), follower));
+
+  p.clear_all(rediscoro::client_errc::connection_lost);
+  EXPECT_EQ(leader->err_count(), 1u);
+  EXPECT_EQ(follower->err_count(), 1u);
+  EXPECT_EQ(group.size(), 0u);
+}
+
+TEST(singleflight_test, limits_bypass_deduplication) {
+  rediscoro::detail::singleflight_group group{{.max_inflight_keys = 1, .max_key_bytes = 64}};
+
+  rediscoro::request a{"GET", "a"};
+  rediscoro::request b{"GET", "b"};
+  rediscoro::request big{"GET", std::string(128, 'x')};
+
+  auto flight = group.lead(a.wire(), std::make_shared<recording_sink>(1));
+  ASSERT_NE(flight, nullptr);
+  EXPECT_EQ(group.lead(b.wire(), std::make_shared<recording_sink>(1)), nullptr);
+
+  group.abandon(flight);
+  EXPECT_EQ(group.size(), 0u);
+  EXPECT_EQ(group.lead(big.wire(), std::make_shared<recording_sink>(1)), nullptr);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/pending_response.hpp>
+#include <rediscoro/error.hpp>
+#include <rediscoro/error_info.hpp>
+#include <rediscoro/resp3/message.hpp>
+#include <rediscoro/slow_request_log.hpp>
+#include <rediscoro/tracing.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace std::chrono_literals;
+
+using rediscoro::slow_request_log;
+using rediscoro::slow_request_record;
+
+namespace {
+
+auto make_info(std::string_view verb) -> rediscoro::request_trace_info {
+  return rediscoro::request_trace_info{
+    .command_count = 1,
+    .wire_bytes = 24,
+    .command = rediscoro::trace_label::from(verb),
+  };
+}
+
+}  // namespace
+
+TEST(slow_request_log_test, keeps_the_most_recent_records_oldest_first) {
+  slow_request_log log{3};
+  EXPECT_TRUE(log.snapshot().empty());
+
+  for (std::uint64_t i = 1; i <= 5; ++i) {
+    log.record(slow_request_record{.generation = i});
+  }
+  auto const records = log.snapshot();
+  ASSERT_EQ(records.size(), 3U);
+  EXPECT_EQ(records[0].generation, 3U);
+  EXPECT_EQ(records[1].generation, 4U);
+  EXPECT_EQ(records[2].generation, 5U);
+  EXPECT_EQ(log.total(), 5U);
+  EXPECT_EQ(log.capacity(), 3U);
+}
+
+TEST(slow_request_log_test, zero_capacity_keeps_one_record) {
+  slow_request_log log{0};
+  log.record(slow_request_record{.generation = 1});
+  log.record(slow_request_record{.generation = 2});
+  auto const records = log.snapshot();
+  ASSERT_EQ(records.size(), 1U);
+  EXPECT_EQ(records[0].generation, 2U);
+}
+
+TEST(slow_request_log_test, sink_records_slow_request_with_phases) {
+  slow_request_log log{4};
+  auto const start = std::chrono::steady_clock::now() - 5ms;
+
+  auto sink = std::make_shared<rediscoro::detail::pending_dynamic_response<std::string>>(1);
+  sink->set_slow_request_log(&log, 1ms, 7, make_info("GET"), start, start + 1us);
+  sink->stamp_written(start + 2us);
+  sink->stamp_reply(start + 3us, start + 4us);
+  sink->add_reply_bytes(11);
+  sink->deliver(rediscoro::resp3::message{rediscoro::resp3::bulk_string{"value"}});
+
+  auto const records = log.snapshot();
+  ASSERT_EQ(records.size(), 1U);
+  auto const& r = records[0];
+  EXPECT_EQ(r.command.view(), "GET");
+  EXPECT_EQ(r.command_count, 1U);
+  EXPECT_EQ(r.request_bytes, 24U);
+  EXPECT_EQ(r.reply_bytes, 11U);
+  EXPECT_GE(r.duration, 5ms);
+  EXPECT_EQ(r.enqueued, start);
+  EXPECT_EQ(r.accepted, start + 1us);
+  EXPECT_EQ(r.written, start + 2us);
+  EXPECT_EQ(r.reply_read, start + 3us);
+  EXPECT_GE(r.completed, start + 5ms);
+  EXPECT_EQ(r.generation, 7U);
+  EXPECT_FALSE(r.error);
+}
+
+TEST(slow_request_log_test, sink_skips_fast_requests_and_keeps_errors) {
+  slow_request_log log{4};
+
+  auto fast = std::make_shared<rediscoro::detail::pending_dynamic_response<std::string>>(1);
+  fast->set_slow_request_log(&log, 1h, 1, make_info("PING"), std::chrono::steady_clock::now(),
+                             {});
+  fast->deliver(rediscoro::resp3::message{rediscoro::resp3::simple_string{"PONG"}});
+  EXPECT_TRUE(log.snapshot().empty());
+
+  auto failed = std::make_shared<rediscoro::detail::pending_dynamic_response<std::string>>(2);
+  failed->set_slow_request_log(&log, 0ns, 2, make_info("SET"), std::chrono::steady_clock::now(),
+                               {});
+  failed->fail_all(rediscoro::error_info{rediscoro::client_errc::connection_lost});
+  auto const records = log.snapshot();
+  ASSERT_EQ(records.size(), 1U);
+  EXPECT_EQ(records[0].error, rediscoro::client_errc::connection_lost);
+  EXPECT_EQ(records[0].written, slow_request_record::time_point{});
+  EXPECT_EQ(records[0].reply_bytes, 0U);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <rediscoro/detail/socket_io.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#if REDISCORO_HAS_NONBLOCKING_RECV
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using rediscoro::detail::nonblocking_read_status;
+using rediscoro::detail::try_read_nonblocking;
+
+#if REDISCORO_HAS_NONBLOCKING_RECV
+
+namespace {
+
+struct socket_pair {
+  int fds[2] = {-1, -1};
+
+  socket_pair() { EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0); }
+  ~socket_pair() {
+    for (int fd : fds) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+TEST(socket_io_test, empty_socket_would_block) {
+  socket_pair sp{};
+  std::array<std::byte, 16> buf{};
+  auto r = try_read_nonblocking(sp.fds[0], buf);
+  EXPECT_EQ(r.status, nonblocking_read_status::would_block);
+  EXPECT_EQ(r.bytes, 0U);
+}
+
+TEST(socket_io_test, reads_queued_bytes) {
+  socket_pair sp{};
+  constexpr std::string_view payload = "+PONG\r\n";
+  ASSERT_EQ(::write(sp.fds[1], payload.data(), payload.size()),
+            static_cast<ssize_t>(payload.size()));
+
+  std::array<std::byte, 16> buf{};
+  auto r = try_read_nonblocking(sp.fds[0], buf);
+  ASSERT_EQ(r.status, nonblocking_read_status::data);
+  ASSERT_EQ(r.bytes, payload.size());
+  EXPECT_EQ(std::string_view(reinterpret_cast<char const*>(buf.data()), r.bytes), payload);
+
+  EXPECT_EQ(try_read_nonblocking(sp.fds[0], buf).status, nonblocking_read_status::would_block);
+}
+
+TEST(socket_io_test, peer_close_reports_eof) {
+  socket_pair sp{};
+  ::close(sp.fds[1]);
+  sp.fds[1] = -1;
+
+  std::array<std::byte, 16> buf{};
+  EXPECT_EQ(try_read_nonblocking(sp.fds[0], buf).status, nonblocking_read_status::eof);
+}
+
+TEST(socket_io_test, invalid_descriptor_reports_error) {
+  socket_pair sp{};
+  int const fd = sp.fds[0];
+  ::close(fd);
+  sp.fds[0] = -1;
+
+  std::array<std::byte, 16> buf{};
+  auto r = try_read_nonblocking(fd, buf);
+  EXPECT_EQ(r.status, nonblocking_read_status::error);
+  EXPECT_TRUE(r.error);
+}
+
+#endif
+
+TEST(socket_io_test, negative_descriptor_would_block) {
+  std::array<std::byte, 16> buf{};
+  EXPECT_EQ(try_read_nonblocking(-1, buf).status, nonblocking_read_status::would_block);
+}